@@ -7,6 +7,7 @@ import sys
 
 # we need the ldmx configuration package to construct the object
 from LDMX.Framework import ldmxcfg
+from LDMX.EventProc.truthSummary import truthSummary
 
 # first, we define the process, which must have a name which identifies this
 # processing pass ("pass name").  Usually, this is set to recon.
@@ -23,9 +24,14 @@ pn_reweight = ldmxcfg.Producer("pn_reweight", "ldmx::PnWeightProcessor")
 # definition of W, see the processor.
 pn_reweight.parameters["w_threshold"] = 1150.
 pn_reweight.parameters["w_theta"] = 100.
+# fits to the inclusive W (theta > 100) plot, the weight is lfit/hfit where
+# lfit = exp([1] - [0]*W) and hfit = exp([1] - [0]*W)*([2] + [3]*W + [4]*W^2 + ...)
+pn_reweight.parameters["lfit_parameters"] = [0.01093, 2.766]
+pn_reweight.parameters["hfit_parameters"] = [0.004008, 11.23, 1.242e-6, -1.964e-9, 
+        8.243e-13, 9.333e-17, -7.584e-20, -1.991e-23, 9.757e-27]
 
 # Define the sequence of event processors to be run
-p.sequence = [pn_reweight]
+p.sequence = [truthSummary, pn_reweight]
 
 # Provide the list of input files to run on
 p.inputFiles=["ldmx_sim_events.root"]
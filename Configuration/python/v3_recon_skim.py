@@ -9,8 +9,11 @@ from LDMX.Framework import ldmxcfg
 # Setup producers with default templates
 from LDMX.EventProc.ecalDigis import ecalDigis
 from LDMX.EventProc.hcalDigis import hcalDigis
+from LDMX.EventProc.ecalClusters import ecalClusters
 from LDMX.EventProc.simpleTrigger import simpleTrigger
 from LDMX.EventProc.trackerHitKiller import trackerHitKiller
+from LDMX.EventProc.stripClusters import stripClusters
+from LDMX.EventProc.truthSummary import truthSummary
 
 p = ldmxcfg.Process("recon")
 p.libraries.append("libEventProc.so")
@@ -19,6 +22,11 @@ p.libraries.append("libEventProc.so")
 pnWeight = ldmxcfg.Producer("pn_reweight", "ldmx::PnWeightProcessor")
 pnWeight.parameters["w_threshold"] = 1150.
 pnWeight.parameters["theta_threshold"] = 100.
+# fits to the inclusive W (theta > 100) plot, the weight is lfit/hfit where
+# lfit = exp([1] - [0]*W) and hfit = exp([1] - [0]*W)*([2] + [3]*W + [4]*W^2 + ...)
+pnWeight.parameters["lfit_parameters"] = [0.01093, 2.766]
+pnWeight.parameters["hfit_parameters"] = [0.004008, 11.23, 1.242e-6, -1.964e-9, 
+        8.243e-13, 9.333e-17, -7.584e-20, -1.991e-23, 9.757e-27]
 
 ecalVeto = ldmxcfg.Producer("ecalVeto", "ldmx::EcalVetoProcessor")
 ecalVeto.parameters["num_ecal_layers"] = 34
@@ -33,15 +41,21 @@ simpleTrigger.parameters["threshold"]   = 1500.0 # MeV
 simpleTrigger.parameters["end_layer"]   = 20 
 
 findable_track = ldmxcfg.Producer("findable", "ldmx::FindableTrackProcessor")
+# masks of the recoil layers required by each strategy, bit n for layer n+1;
+# a strategy listed twice can find a track with either mask
+findable_track.parameters["strategies"] = ["4S", "3S1A", "3S1A", "2S2A", "2A", "2S", "3S"]
+findable_track.parameters["strategy_layer_masks"] = [0xFF, 0x13F, 0x23F, 0x30F, 0x300, 0xF, 0x3F]
 
 ecalSimHitSort = ldmxcfg.Producer("ecalSimHitSort", "ldmx::SimHitSortProcessor")
 ecalSimHitSort.parameters["simHitCollection"]="EcalSimHits"
 ecalSimHitSort.parameters["outputCollection"]="SortedEcalSimHits"
+ecalSimHitSort.parameters["sortBy"]="edep"
 hcalSimHitSort = ldmxcfg.Producer("hcalSimHitSort", "ldmx::SimHitSortProcessor")
 hcalSimHitSort.parameters["simHitCollection"]="HcalSimHits"
 hcalSimHitSort.parameters["outputCollection"]="SortedHcalSimHits"
+hcalSimHitSort.parameters["sortBy"]="edep"
 
-p.sequence=[ecalDigis, hcalDigis, simpleTrigger, ecalVeto, hcalVeto, trackerHitKiller, findable_track, pnWeight, ecalSimHitSort, hcalSimHitSort]
+p.sequence=[truthSummary, ecalDigis, hcalDigis, simpleTrigger, ecalClusters, ecalVeto, hcalVeto, trackerHitKiller, stripClusters, findable_track, pnWeight, ecalSimHitSort, hcalSimHitSort]
 
 # Default to dropping all events
 p.skimDefaultIsDrop()
@@ -0,0 +1,149 @@
+/**
+ * @file ChannelConditions.h
+ * @brief Class that provides per-channel calibration conditions from a
+ *        memory-mapped file
+ */
+
+#ifndef DETDESCR_CHANNELCONDITIONS_H_
+#define DETDESCR_CHANNELCONDITIONS_H_
+
+// STL
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ldmx {
+
+    /**
+     * @struct ChannelCondition
+     * @brief The calibration conditions of one readout channel
+     *
+     * @note
+     * This is also the layout of a channel record in a conditions file, so
+     * it must stay a plain struct of fixed-size fields.
+     */
+    struct ChannelCondition {
+
+        /** Flags of a channel. */
+        enum Flag : uint32_t {
+            /** The channel gives no signal. */
+            DEAD = 1,
+            /** The channel fires without signal. */
+            HOT = 2
+        };
+
+        /** Gain relative to the nominal calibration. */
+        float gain{1};
+
+        /** Pedestal offset, in the units of the channel's amplitude. */
+        float pedestal{0};
+
+        /** Noise RMS, or a negative value to use the default noise. */
+        float noise{-1};
+
+        /** Dead and hot flags of the channel. */
+        uint32_t flags{0};
+
+        /**
+         * @return True if the channel is dead or hot, so its hits should be
+         * dropped.
+         */
+        bool isMasked() const {
+            return flags & (DEAD | HOT);
+        }
+    };
+
+    /**
+     * @class ChannelConditions
+     * @brief Read-only table of channel conditions, indexed by dense channel index
+     *
+     * @note
+     * The table is memory-mapped from a binary conditions file rather than
+     * read into memory, so all of the jobs on a node which use the same file
+     * share its pages.  Channels beyond the end of the table, or all of the
+     * channels if no file is given, have the default conditions.  Use
+     * getInstance() to share one mapping per file within a job.  Conditions
+     * files are written with write() or with the ldmx-make-conditions tool.
+     */
+    class ChannelConditions {
+
+        public:
+
+            /**
+             * Get the shared conditions of a file, mapping the file the first
+             * time it is requested.
+             * @param fileName The conditions file, or an empty string for the
+             * default conditions.
+             * @return The conditions.
+             */
+            static const ChannelConditions& getInstance(const std::string& fileName);
+
+            /**
+             * Create a table with the default conditions for every channel.
+             */
+            ChannelConditions();
+
+            /**
+             * Map a conditions file.
+             * @param fileName The conditions file.
+             * @throw std::runtime_error if the file can't be mapped or isn't a
+             * valid conditions file.
+             */
+            explicit ChannelConditions(const std::string& fileName);
+
+            /**
+             * Class destructor, which unmaps the file.
+             */
+            ~ChannelConditions();
+
+            ChannelConditions(const ChannelConditions&) = delete;
+
+            ChannelConditions& operator=(const ChannelConditions&) = delete;
+
+            /**
+             * @return The number of channels in the table.
+             */
+            unsigned getNumChannels() const {
+                return nChannels_;
+            }
+
+            /**
+             * Get the conditions of a channel in constant time.
+             * @param index The dense channel index.
+             * @return The conditions of the channel, or the default conditions
+             * if the channel isn't in the table.
+             */
+            const ChannelCondition& get(unsigned index) const {
+                return index < nChannels_ ? channels_[index] : DEFAULT_CONDITION;
+            }
+
+            /**
+             * Write a conditions file.
+             * @param fileName The conditions file.
+             * @param channels The conditions, indexed by dense channel index.
+             * @throw std::runtime_error if the file can't be written.
+             */
+            static void write(const std::string& fileName, const std::vector<ChannelCondition>& channels);
+
+        private:
+
+            /** The conditions of channels without an entry. */
+            static const ChannelCondition DEFAULT_CONDITION;
+
+            /** The mapped file, or nullptr. */
+            void* mapping_{nullptr};
+
+            /** The size of the mapped file. */
+            std::size_t mappingSize_{0};
+
+            /** The channel records within the mapped file. */
+            const ChannelCondition* channels_{nullptr};
+
+            /** The number of channel records. */
+            unsigned nChannels_{0};
+    };
+
+}
+
+#endif
@@ -10,6 +10,7 @@
 
 // LDMX
 #include "DetDescr/DetectorID.h"
+#include "DetDescr/IDBitField.h"
 
 namespace ldmx {
 
@@ -19,11 +20,46 @@ namespace ldmx {
      *
      * @note
      * This class provides access to a subdetector ID and layer number.
+     *
+     * The layout is also available at compile time through the static
+     * decode() and encode() functions, which should be used instead of an 
+     * instance on per-hit paths.
      */
     class DefaultDetectorID : public DetectorID {
 
         public:
 
+            /** The subdetector field. */
+            typedef IDBitField<0, 3> SubdetField;
+
+            /** The layer field. */
+            typedef IDBitField<4, 11> LayerField;
+
+            /** The decoded fields of an ID. */
+            struct Fields {
+                unsigned subdet;
+                unsigned layer;
+            };
+
+            /**
+             * Decode the fields of a raw ID without an instance.
+             * @param rawValue The raw ID.
+             * @return The decoded fields.
+             */
+            static Fields decode(RawValue rawValue) {
+                return {SubdetField::decode(rawValue), LayerField::decode(rawValue)};
+            }
+
+            /**
+             * Encode a raw ID without an instance.
+             * @param subdet The subdetector value.
+             * @param layer The layer value.
+             * @return The raw ID.
+             */
+            static constexpr RawValue encode(unsigned subdet, unsigned layer) {
+                return SubdetField::encode(subdet) | LayerField::encode(layer);
+            }
+
             /**
              * Class constructor which adds layer and subdetector fields to the ID definition.
              */
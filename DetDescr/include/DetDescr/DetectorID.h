@@ -11,6 +11,7 @@
 #include <vector>
 
 // LDMX
+#include "DetDescr/IDCodec.h"
 #include "DetDescr/IDField.h"
 
 namespace ldmx {
@@ -118,6 +119,12 @@ namespace ldmx {
              */
             IDField* getField(const std::string& fieldName);
 
+            /**
+             * Get an immutable codec with the same field layout as this ID.
+             * @return The codec of this ID.
+             */
+            IDCodec getCodec();
+
             /**
              * Decode and return a field's value by name (e.g. "layer").
              * @return The value of the field.
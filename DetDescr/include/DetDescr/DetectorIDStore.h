@@ -7,14 +7,27 @@
 #ifndef DETDESCR_DETECTORIDSTORE_H_
 #define DETDESCR_DETECTORIDSTORE_H_
 
+// STL
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
 // LDMX
 #include "DetectorID.h"
+#include "IDCodec.h"
 
 namespace ldmx {
 
     /**
      * @class DetectorIDStore
      * @brief A global store for accessing DetectorID objects
+     *
+     * @note
+     * The store may be read and filled from several threads.  Users which
+     * pack or unpack IDs should get the immutable codec of an ID with
+     * getCodec() rather than the DetectorID itself, whose packed and
+     * unpacked values are shared by everyone holding it.
      */
     class DetectorIDStore {
 
@@ -25,6 +38,11 @@ namespace ldmx {
              */
             typedef std::map<std::string, DetectorID*> DetectorIDMap;
 
+            /**
+             * Type mapping ID codecs to their names.
+             */
+            typedef std::map<std::string, IDCodec> IDCodecMap;
+
             /**
              * Get the global instance of the store.
              * @return The global instance of the store.
@@ -38,17 +56,38 @@ namespace ldmx {
              * Get a detector ID by name.
              * @return The detector ID with the name or <i>nullptr</i> if does not exist.
              */
-            DetectorID* getID(const std::string& name) {
-                return ids[name];
+            DetectorID* getID(const std::string& name) const {
+                std::lock_guard<std::mutex> lock(mutex_);
+                DetectorIDMap::const_iterator it = ids.find(name);
+                return it != ids.end() ? it->second : nullptr;
+            }
+
+            /**
+             * Get the codec of a detector ID by name.  The codec stays valid
+             * for the lifetime of the store.
+             * @return The codec of the detector ID with the name or <i>nullptr</i> if does not exist.
+             */
+            const IDCodec* getCodec(const std::string& name) const {
+                std::lock_guard<std::mutex> lock(mutex_);
+                IDCodecMap::const_iterator it = codecs.find(name);
+                return it != codecs.end() ? &it->second : nullptr;
             }
 
             /**
-             * Add a detector ID by name.
+             * Add a detector ID by name.  An ID can't be replaced, since its
+             * codec may already be in use.
              * @param name The name of the detector ID.
              * @param id The detector ID.
+             * @throw std::invalid_argument if an ID with the name was already added.
              */
             void addID(const std::string& name, DetectorID* id) {
+                IDCodec codec = id->getCodec();
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (ids.find(name) != ids.end()) {
+                    throw std::invalid_argument("[DetectorIDStore] A detector ID named '" + name + "' was already added.");
+                }
                 ids[name] = id;
+                codecs.insert(std::make_pair(name, codec));
             }
 
         private:
@@ -57,6 +96,16 @@ namespace ldmx {
              * The map of names to detector IDs.
              */
             DetectorIDMap ids;
+
+            /**
+             * The map of names to ID codecs.
+             */
+            IDCodecMap codecs;
+
+            /**
+             * Mutex guarding the maps.
+             */
+            mutable std::mutex mutex_;
     };
 
 }
@@ -20,12 +20,65 @@ namespace ldmx {
 
         public:
 
+            /** The module position field. */
+            typedef IDBitField<12, 14> ModuleField;
+
+            /** The cell field. */
+            typedef IDBitField<15, 31> CellField;
+
+            /** The decoded fields of an ECal ID. */
+            struct Fields {
+                unsigned subdet;
+                unsigned layer;
+                unsigned module;
+                unsigned cell;
+            };
+
+            /**
+             * Decode the fields of a raw ECal ID without an instance.
+             * @param rawValue The raw ID.
+             * @return The decoded fields.
+             */
+            static Fields decode(RawValue rawValue) {
+                return {SubdetField::decode(rawValue), LayerField::decode(rawValue), 
+                        ModuleField::decode(rawValue), CellField::decode(rawValue)};
+            }
+
+            /**
+             * Decode the layer, module position and cell of an array of raw
+             * ECal IDs, one field at a time.
+             * @param rawValues The raw IDs.
+             * @param n The number of raw IDs.
+             * @param[out] layers The layers, of size n.
+             * @param[out] modules The module positions, of size n.
+             * @param[out] cells The cells, of size n.
+             */
+            static void decode(const RawValue* rawValues, std::size_t n, 
+                    unsigned* layers, unsigned* modules, unsigned* cells) {
+                LayerField::decode(rawValues, n, layers);
+                ModuleField::decode(rawValues, n, modules);
+                CellField::decode(rawValues, n, cells);
+            }
+
+            /**
+             * Encode a raw ECal ID without an instance.
+             * @param subdet The subdetector value.
+             * @param layer The layer value.
+             * @param module The module position value.
+             * @param cell The cell value.
+             * @return The raw ID.
+             */
+            static constexpr RawValue encode(unsigned subdet, unsigned layer, unsigned module, unsigned cell) {
+                return SubdetField::encode(subdet) | LayerField::encode(layer) 
+                    | ModuleField::encode(module) | CellField::encode(cell);
+            }
+
             /**
              * Adds a cell field and re-initializes the ID.
              */
             EcalDetectorID() {
-	      this->getFieldList()->push_back(new IDField("module_position", 2, 12, 14)); 
-	      this->getFieldList()->push_back(new IDField("cell", 3, 15, 31));
+	      this->getFieldList()->push_back(new IDField("module_position", 2, ModuleField::START_BIT, ModuleField::END_BIT)); 
+	      this->getFieldList()->push_back(new IDField("cell", 3, CellField::START_BIT, CellField::END_BIT));
 	      init();
             }
 
@@ -12,7 +12,12 @@
 #define DETDESCR_ECALHEXREADOUT_H_
 
 // STL
+#include <algorithm>
+#include <cmath>
 #include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 // ROOT
 #include "TH2Poly.h"
@@ -21,18 +26,68 @@ namespace ldmx {
 
     typedef std::pair<double,double> XYCoords;
 
+    /**
+     * @class IDRange
+     * @brief Read-only view of a contiguous array of IDs, e.g. the neighbors of a cell.
+     *
+     * @note
+     * The view points into the arrays of the readout which created it, so it is only valid as long
+     * as that readout is.
+     */
+    class IDRange {
+
+        public:
+
+            IDRange(const int* first, const int* last) : first_(first), last_(last) {}
+
+            const int* begin() const { return first_; }
+
+            const int* end() const { return last_; }
+
+            unsigned size() const { return last_ - first_; }
+
+            bool empty() const { return first_ == last_; }
+
+            int operator[](unsigned i) const { return first_[i]; }
+
+            /** Copy the IDs into a vector. */
+            std::vector<int> toVector() const { return std::vector<int>(first_, last_); }
+
+        private:
+
+            const int* first_;
+            const int* last_;
+    };
+
     /**
      * @class EcalHexReadout
      * @brief Implementation of ECal hexagonal cell readout
      *
      * @note
      * This class defines an integer ID for each cell in a module, convertible with 2D position.
-     * 
+     *
+     * The geometry never changes once built, so processors and sensitive detectors should share
+     * one instance per parameter set through getInstance() instead of each building their own.
      */
     class EcalHexReadout {
 
         public:
 
+            /** 
+             * MUST SYNC MINR AND GAP WITH ECAL.GDML. May change cell count here for eg granularity studies.
+             * minR = center-to-flat module hexagon radius, i.e. currently "Hex_radius" in gdml
+             * nCellsWide = count of cells in neatly-ordered horizontal center row
+             * Cell count calculation:
+             *   N = total cell count (in each module)
+             *   c = nCellsWide as defined below
+             *   Define n through c = 2*n+1
+             *   Then N = 1 + 3n(n+1).
+             *   E.g. c = 23 gives N = 397.
+             */
+            static constexpr double defaultMinR{85.};
+            static constexpr double defaultGap_{0.};
+            static constexpr unsigned defaultNCellsWide{23};
+
             /**
              * Class constructor.
              * @param moduleMinR The center-to-flat radius of an ECal module [mm]. See comments in src.
@@ -40,6 +95,70 @@ namespace ldmx {
              */
             EcalHexReadout(double moduleMinR = defaultMinR, double gap = defaultGap_, unsigned nCellsWide = defaultNCellsWide);
 
+            /**
+             * Class constructor which reads the cells and their neighbors from a cache file. If the
+             * file doesn't exist or was written for other parameters, the geometry is built as usual
+             * and written to the file.
+             * @param moduleMinR The center-to-flat radius of an ECal module [mm].
+             * @param gap The gap between modules [mm].
+             * @param nCellsWide Total cell count in center horizontal row.
+             * @param cacheFile Path of the cache file.
+             */
+            EcalHexReadout(double moduleMinR, double gap, unsigned nCellsWide, const std::string& cacheFile);
+
+            /**
+             * Get the shared readout for a parameter set, building it on first use. Thread safe.
+             * @param moduleMinR The center-to-flat radius of an ECal module [mm].
+             * @param gap The gap between modules [mm].
+             * @param nCellsWide Total cell count in center horizontal row.
+             * @param cacheFile Optional cache file, only used when the readout is first built.
+             */
+            static const EcalHexReadout& getInstance(double moduleMinR = defaultMinR, double gap = defaultGap_,
+                                                     unsigned nCellsWide = defaultNCellsWide, const std::string& cacheFile = "");
+
+            /**
+             * @struct Geometry
+             * @brief The ECal parameters a readout is built from, as in the ecal.gdml of a detector
+             */
+            struct Geometry {
+                /** The center-to-flat radius of an ECal module, "Hex_radius" in ecal.gdml [mm] */
+                double moduleMinR;
+                /** The gap between modules, "hexagon_gap" in ecal.gdml [mm] */
+                double gap;
+                /** Total cell count in center horizontal row */
+                unsigned nCellsWide;
+            };
+
+            /**
+             * Get the ECal geometry parameters of a detector in Detectors/data, for runs which
+             * don't store them in their header.
+             * @param detectorName The detector name, as in the RunHeader.
+             * @return The parameters of the detector.
+             * @throw std::invalid_argument if the detector is not known.
+             */
+            static Geometry getDetectorGeometry(const std::string& detectorName);
+
+            /**
+             * Get the ECal geometry parameters of a run.
+             * @param detectorName The detector name of the run.
+             * @param moduleMinR The module radius stored with the run, or 0 if the run doesn't store it [mm].
+             * @param gap The module gap stored with the run [mm].
+             * @return The parameters stored with the run, or those of its detector if there are none.
+             * @throw std::invalid_argument if the run stores no parameters and the detector is not known.
+             */
+            static Geometry getRunGeometry(const std::string& detectorName, double moduleMinR, double gap);
+
+            /**
+             * Get the shared readout for a geometry, building it on first use. Thread safe.
+             * @param geometry The geometry parameters.
+             * @param cacheFile Optional cache file, only used when the readout is first built.
+             */
+            static const EcalHexReadout& getInstance(const Geometry& geometry, const std::string& cacheFile = "");
+
+            /** The readout owns its TH2Poly maps, so it can't be copied. */
+            EcalHexReadout(const EcalHexReadout&) = delete;
+            EcalHexReadout& operator=(const EcalHexReadout&) = delete;
+
             /**
              * Class destructor.
              */
@@ -73,14 +192,13 @@ namespace ldmx {
              */
             int getModuleID(double x, double y) const {
                 int bestID = -1;
-                double bestDist = 1E6;
-                for(auto const& module : modulePositionMap_) {  
-                    int mID   = module.first;
-                    double mX = module.second.first;
-                    double mY = module.second.second;
-                    double dist = sqrt( (x-mX)*(x-mX) + (y-mY)*(y-mY) );
-                    if(dist < moduler_) return mID;
-                    if(dist < bestDist) { bestID = mID; bestDist = dist; }
+                double bestDist2 = 1E12;
+                for(int mID = 0 ; mID < nModules_ ; mID++) {
+                    double dX = x-moduleX_[mID];
+                    double dY = y-moduleY_[mID];
+                    double dist2 = dX*dX + dY*dY;
+                    if(dist2 < moduler_*moduler_) return mID;
+                    if(dist2 < bestDist2) { bestID = mID; bestDist2 = dist2; }
                 }
                 return bestID;
             }
@@ -92,7 +210,8 @@ namespace ldmx {
              * @param y Any Y position [mm]
              */
             int getCellIDRelative(double x, double y) const {
-                int bin = ecalMap_->FindBin(x,y)-1; // NB FindBin indices starts from 1, our maps start from 0
+                int bin = useLattice_ ? getLatticeCellID(x,y) 
+                                      : ecalMap_->FindBin(x,y)-1; // NB FindBin indices starts from 1, our maps start from 0
                 if(bin < 0) {
                     TString error_msg = TString("[EcalHexReadout::getCellIDRelative] Relative coordinates are outside module hexagon!") + 
                                         TString::Format(" Is the gap used by EcalHexReadout (%.2f mm) and the minimum module radius (%.2f mm)",gap_,moduler_) +
@@ -102,6 +221,17 @@ namespace ldmx {
                 return bin;
             }
 
+            /**
+             * Get a cell ID from an XY position relative to module center with the TH2Poly search.
+             * This is the reference for the faster lookup used by getCellIDRelative().
+             * @param x Any X position [mm]
+             * @param y Any Y position [mm]
+             * @return The cell ID, or a negative value if the position isn't in a cell.
+             */
+            int getPolyCellIDRelative(double x, double y) const {
+                return ecalMap_->FindBin(x,y)-1;
+            }
+
             /**
              * Get a combined cellModule ID from an XY position relative to ecal center.
              * Error is ID < 0 (see TH2Poly for meanings).
@@ -111,8 +241,9 @@ namespace ldmx {
              */
             int getCellModuleID(double x, double y) const {
                 int moduleID = getModuleID(x,y);
-                double relX = x - getModuleCenter(moduleID).first;
-                double relY = y - getModuleCenter(moduleID).second;
+                if(moduleID < 0) throw std::out_of_range("Error: no module found for the position");
+                double relX = x - moduleX_[moduleID];
+                double relY = y - moduleY_[moduleID];
                 int cellID = getCellIDRelative(relX,relY);
                 int cellModuleID = combineID(cellID,moduleID);
                 return cellModuleID;
@@ -139,23 +270,60 @@ namespace ldmx {
              * @return The XY position of the center of the cell. Error is exception.
              */
             XYCoords getCellCenterAbsolute(int cellModuleID) const {
-                return cellModulePositionMap_.at(cellModuleID);
+                int index = getChannelIndexChecked(cellModuleID);
+                return XYCoords(channelX_[index], channelY_[index]);
+            }
+
+            /**
+             * Get the number of channels (cells of all modules) in a layer.
+             */
+            int getNumChannels() const { return channelIDs_.size(); }
+
+            /**
+             * Get the dense channel index, from 0 to getNumChannels()-1, of a combined cellModuleID.
+             *   NB the index is moduleID*(cells per module)+cellID
+             * @param cellModuleID The combined cellModuleID.
+             * @return The channel index, or -1 if the ID isn't a valid channel.
+             */
+            int getChannelIndex(int cellModuleID) const {
+                if (cellModuleID < 0) return -1;
+                int cellID = cellModuleID/10;
+                int moduleID = cellModuleID % 10;
+                if (cellID >= nCells_ || moduleID >= nModules_) return -1;
+                return moduleID*nCells_ + cellID;
             }
 
             /**
-             * @param Return NN IDs, which are combined cellModuleIDs. Normally six. Return by copy.
+             * Get the combined cellModuleID of a dense channel index.
+             */
+            int getCellModuleIDFromIndex(int index) const { return channelIDs_[index]; }
+
+            /**
+             * Get the cell center X position relative to ecal center of a dense channel index [mm].
+             */
+            double getChannelX(int index) const { return channelX_[index]; }
+
+            /**
+             * Get the cell center Y position relative to ecal center of a dense channel index [mm].
+             */
+            double getChannelY(int index) const { return channelY_[index]; }
+
+            /**
+             * @param Return NN IDs, which are combined cellModuleIDs sorted by value. Normally six.
              *   NB cellModuleIDs are: 10*cellID+moduleID
              */
-            std::vector<int> getNN(int cellModuleID) const {
-              return NNMap_.at(cellModuleID);
+            IDRange getNN(int cellModuleID) const {
+                int index = getChannelIndexChecked(cellModuleID);
+                return IDRange(neighborIDs_.data() + neighborOffsets_[index], neighborIDs_.data() + nnEnds_[index]);
             }
 
             /**
-             * @param Return NNN IDs, which are cellModuleIDs. Normally twelve. Return by copy.
+             * @param Return NNN IDs, which are cellModuleIDs sorted by value. Normally twelve.
              *   NB cellModuleIDs are: 10*cellID+moduleID
              */
-            std::vector<int> getNNN(int cellModuleID) const {
-              return NNNMap_.at(cellModuleID);
+            IDRange getNNN(int cellModuleID) const {
+                int index = getChannelIndexChecked(cellModuleID);
+                return IDRange(neighborIDs_.data() + nnEnds_[index], neighborIDs_.data() + neighborOffsets_[index + 1]);
             }
 
             /**
@@ -163,10 +331,8 @@ namespace ldmx {
              *   NB cellModuleIDs are: 10*cellID+moduleID
              */
             bool isNN(int centerID, int probeID) const {
-                for (auto ID: getNN(centerID)) {
-                    if (ID == probeID) return true;
-                }
-                return false;
+                IDRange nn = getNN(centerID);
+                return std::binary_search(nn.begin(), nn.end(), probeID);
             }
 
             /**
@@ -174,10 +340,8 @@ namespace ldmx {
              *   NB cellModuleIDs are: 10*cellID+moduleID
              */
             bool isNNN(int centerID, int probeID) const {
-                for (auto ID: getNNN(centerID)) {
-                    if (ID == probeID) return true;
-                }
-                return false;
+                IDRange nnn = getNNN(centerID);
+                return std::binary_search(nnn.begin(), nnn.end(), probeID);
             }
 
             /**
@@ -223,6 +387,30 @@ namespace ldmx {
 
         private:
 
+            /**
+             * Computes the cell and module radii from the constructor parameters.
+             */
+            void setRadii(double moduleMinR, double gap, unsigned nCellsWide);
+
+            /**
+             * Builds all maps from scratch.
+             */
+            void buildMaps();
+
+            /**
+             * Reads the cells and neighbor maps from a cache file, and builds the remaining maps.
+             * @param cacheFile Path of the cache file.
+             * @return Whether the cache exists, is complete, and matches the parameters and
+             *   byte order of this readout.
+             */
+            bool readCache(const std::string& cacheFile);
+
+            /**
+             * Writes the cells and neighbor maps to a cache file, in the byte order of the host.
+             * @param cacheFile Path of the cache file.
+             */
+            void writeCache(const std::string& cacheFile) const;
+
             /**
              * Constructs the positions of the seven modules (moduleID) relative to the ecal center
              */
@@ -243,7 +431,51 @@ namespace ldmx {
             void buildCellModuleMap();
 
             /**
-             * Construts NNMap and NNNMap
+             * Get a cell ID from an XY position relative to module center, by rounding to the nearest
+             * center of the cell lattice in axial coordinates. The cells are the Voronoi regions of the
+             * lattice, so this finds the same cell as the TH2Poly search, in constant time.
+             * @return The cell ID, or -1 if the nearest lattice cell isn't part of the module.
+             */
+            int getLatticeCellID(double x, double y) const {
+                // axial coordinates of a corner-down hexagonal lattice with a cell at (0,0)
+                double q = (x*(sqrt(3.)/3.) - y/3.)/cellR_;
+                double r = (2./3.)*y/cellR_;
+                double s = -q - r;
+                long roundQ = lround(q), roundR = lround(r), roundS = lround(s);
+                double dQ = fabs(roundQ - q), dR = fabs(roundR - r), dS = fabs(roundS - s);
+                if(dQ > dR && dQ > dS) roundQ = -roundR - roundS;
+                else if(dR > dS) roundR = -roundQ - roundS;
+                long column = roundQ + latticeHalfWidth_;
+                long row = roundR + latticeHalfWidth_;
+                if(column < 0 || row < 0 || column > 2*latticeHalfWidth_ || row > 2*latticeHalfWidth_) return -1;
+                return latticeCells_[row*(2*latticeHalfWidth_+1) + column];
+            }
+
+            /**
+             * Builds the table of cell IDs by lattice position used by getLatticeCellID(). The TH2Poly
+             * search is kept if the cell centers don't lie on the lattice.
+             */
+            void buildLatticeTable();
+
+            /**
+             * Get the dense channel index of a combined cellModuleID, throwing if it isn't valid.
+             */
+            int getChannelIndexChecked(int cellModuleID) const {
+                int index = getChannelIndex(cellModuleID);
+                if (index < 0) throw std::out_of_range("Error: cellModuleID " + std::to_string(cellModuleID) + " is not valid");
+                return index;
+            }
+
+            /**
+             * Flattens neighbor maps, keyed by cellModuleID, into the neighbor arrays.
+             * @param NNMap The NN IDs of each cell.
+             * @param NNNMap The NNN IDs of each cell.
+             */
+            void setNeighbors(const std::map<int, std::vector<int> >& NNMap, const std::map<int, std::vector<int> >& NNNMap);
+
+            /**
+             * Construts the neighbor arrays. Cell centers are hashed into square bins as wide as the
+             * NNN radius, so only the cells in the 3x3 bins around each cell are compared.
              */
             void buildNeighborMaps();
 
@@ -262,26 +494,37 @@ namespace ldmx {
             std::map<int, XYCoords> modulePositionMap_;
             std::map<int, XYCoords> cellPositionMap_;
             std::map<int, XYCoords> cellModulePositionMap_;
-            std::map<int, std::vector<int> > NNMap_;
-            std::map<int, std::vector<int> > NNNMap_;
 
-            /** 
-             * MUST SYNC MINR AND GAP WITH ECAL.GDML. May change cell count here for eg granularity studies.
-             * minR = center-to-flat module hexagon radius, i.e. currently "Hex_radius" in gdml
-             * nCellsWide = count of cells in neatly-ordered horizontal center row
-             * Cell count calculation:
-             *   N = total cell count (in each module)
-             *   c = nCellsWide as defined below
-             *   Define n through c = 2*n+1
-             *   Then N = 1 + 3n(n+1).
-             *   E.g. c = 23 gives N = 397.
+            int nModules_{0};
+            int nCells_{0};
+
+            /** module center positions relative to ecal center, indexed by moduleID */
+            std::vector<double> moduleX_;
+            std::vector<double> moduleY_;
+
+            /**
+             * Cell ID of each lattice position (q,r), at index (r+halfWidth)*(2*halfWidth+1)+(q+halfWidth),
+             * or -1 if that position isn't a cell of the module.
              */
-            static constexpr double defaultMinR{85.};
-            static constexpr double defaultGap_{0.};
-            static constexpr unsigned defaultNCellsWide{23};
+            bool useLattice_{false};
+            long latticeHalfWidth_{0};
+            std::vector<int> latticeCells_;
+
+            /** cellModuleID, and cell center position relative to ecal center, of each channel index */
+            std::vector<int> channelIDs_;
+            std::vector<double> channelX_;
+            std::vector<double> channelY_;
+
+            /**
+             * Neighbors of each channel index, as cellModuleIDs. The NN IDs of channel i are at
+             * [neighborOffsets_[i], nnEnds_[i]) and the NNN IDs at [nnEnds_[i], neighborOffsets_[i+1]).
+             */
+            std::vector<int> neighborOffsets_;
+            std::vector<int> nnEnds_;
+            std::vector<int> neighborIDs_;
 
-            TH2Poly* ecalMap_;
-            TH2Poly* gridMap_;
+            TH2Poly* ecalMap_{nullptr};
+            TH2Poly* gridMap_{nullptr};
     };
 
 }
@@ -31,9 +31,62 @@ namespace ldmx {
 
         public:
 
+            /** The section field. */
+            typedef IDBitField<12, 14> SectionField;
+
+            /** The strip field. */
+            typedef IDBitField<15, 22> StripField;
+
+            /** The decoded fields of an HCal ID. */
+            struct Fields {
+                unsigned subdet;
+                unsigned layer;
+                unsigned section;
+                unsigned strip;
+            };
+
+            /**
+             * Decode the fields of a raw HCal ID without an instance.
+             * @param rawValue The raw ID.
+             * @return The decoded fields.
+             */
+            static Fields decode(RawValue rawValue) {
+                return {SubdetField::decode(rawValue), LayerField::decode(rawValue), 
+                        SectionField::decode(rawValue), StripField::decode(rawValue)};
+            }
+
+            /**
+             * Decode the layer, section and strip of an array of raw HCal
+             * IDs, one field at a time.
+             * @param rawValues The raw IDs.
+             * @param n The number of raw IDs.
+             * @param[out] layers The layers, of size n.
+             * @param[out] sections The sections, of size n.
+             * @param[out] strips The strips, of size n.
+             */
+            static void decode(const RawValue* rawValues, std::size_t n, 
+                    unsigned* layers, unsigned* sections, unsigned* strips) {
+                LayerField::decode(rawValues, n, layers);
+                SectionField::decode(rawValues, n, sections);
+                StripField::decode(rawValues, n, strips);
+            }
+
+            /**
+             * Encode a raw HCal ID without an instance.
+             * @param subdet The subdetector value.
+             * @param layer The layer value.
+             * @param section The section value.
+             * @param strip The strip value.
+             * @return The raw ID.
+             */
+            static constexpr RawValue encode(unsigned subdet, unsigned layer, unsigned section, unsigned strip) {
+                return SubdetField::encode(subdet) | LayerField::encode(layer) 
+                    | SectionField::encode(section) | StripField::encode(strip);
+            }
+
             HcalID() {
-                this->getFieldList()->push_back(new IDField("section", 2, 12, 14));
-                this->getFieldList()->push_back(new IDField("strip", 3, 15, 22));
+                this->getFieldList()->push_back(new IDField("section", 2, SectionField::START_BIT, SectionField::END_BIT));
+                this->getFieldList()->push_back(new IDField("strip", 3, StripField::START_BIT, StripField::END_BIT));
                 init();
             }
 
@@ -0,0 +1,91 @@
+/**
+ * @file IDBitField.h
+ * @brief Compile-time description of a field in a bit-packed detector ID
+ */
+
+#ifndef DETDESCR_IDBITFIELD_H_
+#define DETDESCR_IDBITFIELD_H_
+
+#include <cstddef>
+
+namespace ldmx {
+
+    /**
+     * @class IDBitField
+     * @brief Encodes and decodes one field of a bit-packed detector ID
+     *
+     * @note
+     * This is the compile-time counterpart of IDField, for IDs whose layout
+     * is fixed in the code.  Decoding is a shift and a mask which the
+     * compiler can inline, with no field list, name lookup or heap
+     * allocation involved.
+     *
+     * @tparam START The start bit of the field.
+     * @tparam END The end bit of the field, inclusive.
+     */
+    template <unsigned START, unsigned END>
+    struct IDBitField {
+
+        static_assert(START <= END && END < 32, "An ID field must lie within the 32 bits of the ID.");
+
+        /** The start bit of the field. */
+        static constexpr unsigned START_BIT = START;
+
+        /** The end bit of the field. */
+        static constexpr unsigned END_BIT = END;
+
+        /** The number of bits of the field. */
+        static constexpr unsigned WIDTH = END - START + 1;
+
+        /** Mask of the field value, before it is shifted into place. */
+        static constexpr unsigned VALUE_MASK = (WIDTH == 32) ? 0xFFFFFFFF : ((1u << WIDTH) - 1);
+
+        /** Mask of the field within the raw ID. */
+        static constexpr unsigned MASK = VALUE_MASK << START;
+
+        /**
+         * Decode the value of the field.
+         * @param rawValue The raw ID.
+         * @return The value of the field.
+         */
+        static constexpr unsigned decode(unsigned rawValue) {
+            return (rawValue >> START) & VALUE_MASK;
+        }
+
+        /**
+         * Encode a value of the field, which can be OR'ed with the other
+         * fields of the ID.  Bits of the value outside of the field are
+         * dropped.
+         * @param value The value of the field.
+         * @return The field value shifted into place.
+         */
+        static constexpr unsigned encode(unsigned value) {
+            return (value & VALUE_MASK) << START;
+        }
+
+        /**
+         * Replace the value of the field in a raw ID.
+         * @param rawValue The raw ID.
+         * @param value The new value of the field.
+         * @return The raw ID with the new field value.
+         */
+        static constexpr unsigned replace(unsigned rawValue, unsigned value) {
+            return (rawValue & ~MASK) | encode(value);
+        }
+
+        /**
+         * Decode the value of the field for an array of raw IDs.  The loop
+         * has no branches or shared state, so the compiler can vectorize it.
+         * @param rawValues The raw IDs.
+         * @param n The number of raw IDs.
+         * @param[out] values The values of the field, of size n.
+         */
+        static void decode(const unsigned* rawValues, std::size_t n, unsigned* values) {
+            for (std::size_t i = 0; i < n; ++i) {
+                values[i] = (rawValues[i] >> START) & VALUE_MASK;
+            }
+        }
+    };
+}
+
+#endif // DETDESCR_IDBITFIELD_H_
@@ -0,0 +1,115 @@
+/**
+ * @file IDCodec.h
+ * @brief Class that packs and unpacks raw IDs with an immutable field layout
+ */
+
+#ifndef DETDESCR_IDCODEC_H_
+#define DETDESCR_IDCODEC_H_
+
+// STL
+#include <string>
+#include <vector>
+
+// LDMX
+#include "DetDescr/IDField.h"
+
+namespace ldmx {
+
+    /**
+     * @class IDCodec
+     * @brief Packs and unpacks raw IDs with a field layout fixed at construction
+     *
+     * @note
+     * Unlike DetectorID, a codec keeps no packed or unpacked values of its
+     * own.  Every function is const and works on a raw value passed by the
+     * caller, so a single codec can be shared between threads and IDs can be
+     * packed into local variables without any shared writes.
+     */
+    class IDCodec {
+
+        public:
+
+            /**
+             * Definition of the raw value type.
+             */
+            typedef unsigned RawValue;
+
+            /**
+             * Definition of the field value type.
+             */
+            typedef unsigned FieldValue;
+
+            /**
+             * Class constructor, which copies the layout of the fields.
+             * @param fieldList The list of fields.
+             */
+            IDCodec(const IDField::IDFieldList& fieldList);
+
+            /**
+             * Get the number of fields.
+             * @return The number of fields.
+             */
+            unsigned getNumFields() const {
+                return fields_.size();
+            }
+
+            /**
+             * Get the index of a field by name.
+             * @param fieldName The name of the field.
+             * @return The index of the field or -1 if it does not exist.
+             */
+            int getFieldIndex(const std::string& fieldName) const;
+
+            /**
+             * Decode a field's value from a raw ID.
+             * @param rawValue The raw ID.
+             * @param i The index of the field.
+             * @return The value of the field, or 0 if there is no field with the index.
+             */
+            FieldValue decode(RawValue rawValue, unsigned i) const {
+                if (i >= fields_.size()) return 0;
+                const Field& field = fields_[i];
+                return (rawValue & field.mask) >> field.startBit;
+            }
+
+            /**
+             * Set a field's value in a raw ID.  Bits of the value outside of
+             * the field are dropped rather than spilling into other fields.
+             * @param rawValue The raw ID.
+             * @param i The index of the field.
+             * @param value The new value of the field.
+             * @return The raw ID with the new field value, or unchanged if there is no
+             *   field with the index.
+             */
+            RawValue encode(RawValue rawValue, unsigned i, FieldValue value) const {
+                if (i >= fields_.size()) return rawValue;
+                const Field& field = fields_[i];
+                return (rawValue & ~field.mask) | ((value << field.startBit) & field.mask);
+            }
+
+        private:
+
+            /**
+             * The layout of a field.
+             */
+            struct Field {
+
+                /** The name of the field. */
+                std::string name;
+
+                /** The start bit of the field. */
+                unsigned startBit;
+
+                /** The bit mask of the field within the raw ID. */
+                unsigned mask;
+            };
+
+            /**
+             * The fields ordered by index.
+             */
+            std::vector<Field> fields_;
+    };
+
+}
+
+#endif
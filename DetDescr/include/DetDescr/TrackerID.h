@@ -20,11 +20,54 @@ namespace ldmx {
 
         public:
 
+            /** The module field. */
+            typedef IDBitField<12, 16> ModuleField;
+
+            /** The decoded fields of a tracker ID. */
+            struct Fields {
+                unsigned subdet;
+                unsigned layer;
+                unsigned module;
+            };
+
+            /**
+             * Decode the fields of a raw tracker ID without an instance.
+             * @param rawValue The raw ID.
+             * @return The decoded fields.
+             */
+            static Fields decode(RawValue rawValue) {
+                return {SubdetField::decode(rawValue), LayerField::decode(rawValue), ModuleField::decode(rawValue)};
+            }
+
+            /**
+             * Decode the layer and module of an array of raw tracker IDs, one
+             * field at a time.
+             * @param rawValues The raw IDs.
+             * @param n The number of raw IDs.
+             * @param[out] layers The layers, of size n.
+             * @param[out] modules The modules, of size n.
+             */
+            static void decode(const RawValue* rawValues, std::size_t n, unsigned* layers, unsigned* modules) {
+                LayerField::decode(rawValues, n, layers);
+                ModuleField::decode(rawValues, n, modules);
+            }
+
+            /**
+             * Encode a raw tracker ID without an instance.
+             * @param subdet The subdetector value.
+             * @param layer The layer value.
+             * @param module The module value.
+             * @return The raw ID.
+             */
+            static constexpr RawValue encode(unsigned subdet, unsigned layer, unsigned module) {
+                return SubdetField::encode(subdet) | LayerField::encode(layer) | ModuleField::encode(module);
+            }
+
             /**
              * Add a module field and reinitialize the ID.
              */
             TrackerID() {
-                this->getFieldList()->push_back(new IDField("module", 2, 12, 16));
+                this->getFieldList()->push_back(new IDField("module", 2, ModuleField::START_BIT, ModuleField::END_BIT));
                 init();
             }
 
@@ -0,0 +1,110 @@
+#include "DetDescr/ChannelConditions.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace ldmx {
+
+    /** Header at the start of a conditions file. */
+    struct ConditionsHeader {
+
+        /** Identifies a conditions file. */
+        uint32_t magic;
+
+        /** Version of the file layout. */
+        uint32_t version;
+
+        /** Number of channel records after the header. */
+        uint32_t nChannels;
+
+        /** Size of a channel record, to catch layout changes. */
+        uint32_t recordSize;
+    };
+
+    /** Identifies a conditions file. */
+    static const uint32_t CONDITIONS_MAGIC{0x434e4843};
+
+    /** Version of the conditions file layout. */
+    static const uint32_t CONDITIONS_VERSION{1};
+
+    static_assert(sizeof(ConditionsHeader) == 16 && sizeof(ChannelCondition) == 16,
+            "The conditions file layout must not depend on padding.");
+
+    const ChannelCondition ChannelConditions::DEFAULT_CONDITION = ChannelCondition();
+
+    const ChannelConditions& ChannelConditions::getInstance(const std::string& fileName) {
+        static std::mutex instanceMutex;
+        static std::map<std::string, std::unique_ptr<ChannelConditions> > instances;
+
+        std::lock_guard<std::mutex> lock(instanceMutex);
+        std::unique_ptr<ChannelConditions>& instance = instances[fileName];
+        if (!instance) instance.reset(fileName.empty() ? new ChannelConditions() : new ChannelConditions(fileName));
+        return *instance;
+    }
+
+    ChannelConditions::ChannelConditions() {
+    }
+
+    ChannelConditions::ChannelConditions(const std::string& fileName) {
+
+        int fd = open(fileName.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Unable to open conditions file " + fileName + ": " + strerror(errno));
+        }
+
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) != 0 || fileStat.st_size < (off_t)sizeof(ConditionsHeader)) {
+            close(fd);
+            throw std::runtime_error("Conditions file " + fileName + " is too short.");
+        }
+
+        mappingSize_ = fileStat.st_size;
+        mapping_ = mmap(nullptr, mappingSize_, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping_ == MAP_FAILED) {
+            mapping_ = nullptr;
+            throw std::runtime_error("Unable to map conditions file " + fileName + ": " + strerror(errno));
+        }
+
+        const ConditionsHeader* header = static_cast<const ConditionsHeader*>(mapping_);
+        if (header->magic != CONDITIONS_MAGIC || header->version != CONDITIONS_VERSION
+                || header->recordSize != sizeof(ChannelCondition)
+                || mappingSize_ < sizeof(ConditionsHeader) + std::size_t(header->nChannels)*sizeof(ChannelCondition)) {
+            munmap(mapping_, mappingSize_);
+            mapping_ = nullptr;
+            throw std::runtime_error("File " + fileName + " is not a valid conditions file.");
+        }
+
+        channels_ = reinterpret_cast<const ChannelCondition*>(header + 1);
+        nChannels_ = header->nChannels;
+    }
+
+    ChannelConditions::~ChannelConditions() {
+        if (mapping_) munmap(mapping_, mappingSize_);
+    }
+
+    void ChannelConditions::write(const std::string& fileName, const std::vector<ChannelCondition>& channels) {
+        std::ofstream out(fileName, std::ios::binary);
+        if (!out) {
+            throw std::runtime_error("Unable to write conditions file " + fileName);
+        }
+
+        ConditionsHeader header{CONDITIONS_MAGIC, CONDITIONS_VERSION, uint32_t(channels.size()), sizeof(ChannelCondition)};
+        out.write((const char*)&header, sizeof(header));
+        out.write((const char*)channels.data(), channels.size()*sizeof(ChannelCondition));
+        if (!out) {
+            throw std::runtime_error("Error writing conditions file " + fileName);
+        }
+    }
+
+}
@@ -4,8 +4,8 @@ namespace ldmx {
 
     DefaultDetectorID::DefaultDetectorID() : DetectorID() {
         IDField::IDFieldList* fieldList = new IDField::IDFieldList();
-        fieldList->push_back(new IDField("subdet", 0, 0, 3));
-        fieldList->push_back(new IDField("layer", 1, 4, 11));
+        fieldList->push_back(new IDField("subdet", 0, SubdetField::START_BIT, SubdetField::END_BIT));
+        fieldList->push_back(new IDField("layer", 1, LayerField::START_BIT, LayerField::END_BIT));
 
         setFieldList(fieldList);
     }
@@ -70,6 +70,10 @@ namespace ldmx {
         return fieldMap_[fieldName];
     }
 
+    IDCodec DetectorID::getCodec() {
+        return IDCodec(*fieldList_);
+    }
+
     DetectorID::FieldValue DetectorID::getFieldValue(const std::string& fieldName) {
         return getFieldValue(fieldMap_[fieldName]->getIndex());
     }
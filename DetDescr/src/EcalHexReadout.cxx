@@ -6,11 +6,86 @@
 #include "TMultiGraph.h"
 
 #include <assert.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
 
 namespace ldmx {
 
+    /**
+     * Identifies an EcalHexReadout cache file.  The cache is written in the byte
+     * order of the host, so a cache written on a host of the other byte order
+     * fails this check and is rebuilt.
+     */
+    static const unsigned CACHE_MAGIC{0x45485243};
+
+    /** Version of the cache file layout. */
+    static const unsigned CACHE_VERSION{1};
+
+    /**
+     * ECal geometry of the detectors in Detectors/data, for runs simulated before the geometry
+     * was stored in the run header.  It is the Hex_radius and hexagon_gap of the ecal.gdml, or
+     * the module solids and positions of the older, generated ecal.gdml without them.  Newer
+     * runs store the parameters read from the GDML, so new detectors don't need to be listed.
+     *   NB the v1 detector reports the name ldmx-det-full-v0-fieldmap
+     */
+    static const std::map<std::string, EcalHexReadout::Geometry> DETECTOR_GEOMETRIES{
+        {"ldmx-det-full-v0",                 {85., 0., 23}},
+        {"ldmx-det-full-v0-fieldmap",        {85., 0., 23}},
+        {"ldmx-det-full-v2-fieldmap",        {85., 0., 23}},
+        {"ldmx-det-full-v3-fieldmap",        {85., 0., 23}},
+        {"ldmx-det-full-v3-fieldmap-magnet", {85., 0., 23}},
+        {"ldmx-det-full-v4-fieldmap-magnet", {85., 0., 23}}
+    };
+
     EcalHexReadout::EcalHexReadout(double moduleMinR, double gap, unsigned nCellsWide){
+        setRadii(moduleMinR, gap, nCellsWide);
+        buildMaps();
+    }
+
+    EcalHexReadout::EcalHexReadout(double moduleMinR, double gap, unsigned nCellsWide, const std::string& cacheFile){
+        setRadii(moduleMinR, gap, nCellsWide);
+        if(!cacheFile.empty() && readCache(cacheFile)) return;
+        buildMaps();
+        if(!cacheFile.empty()) writeCache(cacheFile);
+    }
+
+    const EcalHexReadout& EcalHexReadout::getInstance(double moduleMinR, double gap, unsigned nCellsWide, const std::string& cacheFile){
+        typedef std::tuple<double,double,unsigned> Parameters;
+        static std::mutex instanceMutex;
+        static std::map<Parameters, std::unique_ptr<EcalHexReadout> > instances;
+
+        std::lock_guard<std::mutex> lock(instanceMutex);
+        std::unique_ptr<EcalHexReadout>& instance = instances[Parameters(moduleMinR, gap, nCellsWide)];
+        if(!instance) instance.reset(new EcalHexReadout(moduleMinR, gap, nCellsWide, cacheFile));
+        return *instance;
+    }
+
+    EcalHexReadout::Geometry EcalHexReadout::getDetectorGeometry(const std::string& detectorName){
+        auto search = DETECTOR_GEOMETRIES.find(detectorName);
+        if(search == DETECTOR_GEOMETRIES.end()) {
+            throw std::invalid_argument("[EcalHexReadout] The ECal geometry of detector '" + detectorName + "' is unknown."
+                                        " Its runs must store the hex readout parameters.");
+        }
+        return search->second;
+    }
+
+    EcalHexReadout::Geometry EcalHexReadout::getRunGeometry(const std::string& detectorName, double moduleMinR, double gap){
+        if(moduleMinR > 0) return Geometry{moduleMinR, gap, defaultNCellsWide};
+        return getDetectorGeometry(detectorName);
+    }
+
+    const EcalHexReadout& EcalHexReadout::getInstance(const Geometry& geometry, const std::string& cacheFile){
+        return getInstance(geometry.moduleMinR, geometry.gap, geometry.nCellsWide, cacheFile);
+    }
+
+    void EcalHexReadout::setRadii(double moduleMinR, double gap, unsigned nCellsWide){
 
         // ORIENTATION ASSUMPTIONS:
         //   modules are oriented flat side down. cells are oriented corner side down.
@@ -63,12 +138,15 @@ namespace ldmx {
             std::cout << TString::Format("Building module map with gap %.2f, lengthWide %.2f, nCellsWide %d ",gap_,lengthWide_,nCellsWide_) << std::endl;
             std::cout << TString::Format("  min/max radii of cell %.2f %.2f and module %.2f %.2f",cellr_,cellR_,moduler_,moduleR_) << std::endl;
         }
+    }
 
+    void EcalHexReadout::buildMaps(){
         ecalMap_ = new TH2Poly();
         gridMap_ = new TH2Poly();
         buildModuleMap();
         buildCellMap();
         buildCellModuleMap();
+        buildLatticeTable();
         buildNeighborMaps();
         if(verbose_>0){ std::cout << std::endl; }
     }
@@ -84,6 +162,12 @@ namespace ldmx {
             modulePositionMap_[id] = std::pair<double,double>(x,y);
             if(verbose_>2) std::cout << TString::Format("   id %d is at (%.2f, %.2f)",id,x,y) << std::endl;
         }
+        moduleX_.clear();
+        moduleY_.clear();
+        for(auto const& module : modulePositionMap_) {
+            moduleX_.push_back(module.second.first);
+            moduleY_.push_back(module.second.second);
+        }
         if(verbose_>0) std::cout << std::endl;
     }
 
@@ -104,6 +188,19 @@ namespace ldmx {
             }
         }
         if(verbose_>0) std::cout << "  contained " << cellModulePositionMap_.size() << " entries. " << std::endl;
+
+        // flat arrays ordered by the dense channel index
+        nModules_ = modulePositionMap_.size();
+        nCells_ = cellPositionMap_.size();
+        channelIDs_.assign(nModules_*nCells_, -1);
+        channelX_.assign(nModules_*nCells_, 0.);
+        channelY_.assign(nModules_*nCells_, 0.);
+        for(auto const& channel : cellModulePositionMap_) {
+            int index = getChannelIndex(channel.first);
+            channelIDs_[index] = channel.first;
+            channelX_[index] = channel.second.first;
+            channelY_[index] = channel.second.second;
+        }
     }
 
     void EcalHexReadout::buildCellMap(){
@@ -190,34 +287,54 @@ namespace ldmx {
          */
         if(verbose_>0) std::cout << std::endl << TString::Format("[buildNeighborMap] Building with %d cells wide", nCellsWide_) << std::endl;
 
-        NNMap_.clear();
-        NNNMap_.clear();
+        std::map<int, std::vector<int> > NNMap, NNNMap;
+
+        // hash the cell centers into bins at least as wide as the NNN radius,
+        // so all neighbors of a cell are in the 3x3 bins around it
+        double binWidth = 4.5*cellr_;
+        auto binKey = [](long long binX, long long binY) { 
+            return (static_cast<unsigned long long>(binX) << 32) ^ static_cast<uint32_t>(binY); 
+        };
+        std::unordered_map<unsigned long long, std::vector<int> > bins;
+        for(auto const& channel : cellModulePositionMap_) {
+            long long binX = std::floor(channel.second.first/binWidth);
+            long long binY = std::floor(channel.second.second/binWidth);
+            bins[binKey(binX, binY)].push_back(channel.first);
+        }
+
         for(auto const& centerChannel : cellModulePositionMap_) {
             int centerID = centerChannel.first;
             double centerX = centerChannel.second.first;
             double centerY = centerChannel.second.second;
-            for(auto const& probeChannel : cellModulePositionMap_) {
-                int probeID = probeChannel.first;
-                double probeX = probeChannel.second.first;
-                double probeY = probeChannel.second.second;
-                double dist = sqrt( (probeX-centerX)*(probeX-centerX) + (probeY-centerY)*(probeY-centerY) );
-                if(      dist > 1*cellr_  && dist <= 3.*cellr_)  { NNMap_[centerID].push_back(probeID); }
-                else if( dist > 3.*cellr_ && dist <= 4.5*cellr_) {NNNMap_[centerID].push_back(probeID); }
+            long long centerBinX = std::floor(centerX/binWidth);
+            long long centerBinY = std::floor(centerY/binWidth);
+            for(long long binX = centerBinX-1 ; binX <= centerBinX+1 ; binX++){
+                for(long long binY = centerBinY-1 ; binY <= centerBinY+1 ; binY++){
+                    auto bin = bins.find(binKey(binX, binY));
+                    if(bin == bins.end()) continue;
+                    for(int probeID : bin->second) {
+                        const XYCoords& probe = cellModulePositionMap_.at(probeID);
+                        double dist = sqrt( (probe.first-centerX)*(probe.first-centerX) + (probe.second-centerY)*(probe.second-centerY) );
+                        if(      dist > 1*cellr_  && dist <= 3.*cellr_)  { NNMap[centerID].push_back(probeID); }
+                        else if( dist > 3.*cellr_ && dist <= 4.5*cellr_) {NNNMap[centerID].push_back(probeID); }
+                    }
+                }
             }
             if(verbose_>1) std::cout << TString::Format("Found %d NN and %d NNN for cellModuleID %d with x,y (%.2f,%.2f)",
-                                                        NNMap_[centerID].size(), NNNMap_[centerID].size(), centerID, centerX, centerY) << std::endl;
+                                                        NNMap[centerID].size(), NNNMap[centerID].size(), centerID, centerX, centerY) << std::endl;
         }
+        setNeighbors(NNMap, NNNMap);
         if(verbose_>2){
             double specialX = 0.5*moduleR_ - 0.5*cellr_; // center of cell which is upper-right corner of center module
             double specialY = moduler_ - 0.5*cellR_;
             int specialCellModuleID = getCellModuleID(specialX,specialY);
             std::cout << "The neighbors of the bin in the upper-right corner of the center module, with cellModuleID " 
                       << specialCellModuleID << " include " << std::endl;
-            for(auto centerNN : NNMap_.at(specialCellModuleID)){
+            for(auto centerNN : getNN(specialCellModuleID)){
                 std::cout << TString::Format(" NN ID %d (x,y) (%.2f, %.2f)",
                              centerNN,getCellCenterAbsolute(centerNN).first,getCellCenterAbsolute(centerNN).second) << std::endl;
             }
-            for(auto centerNNN : NNNMap_.at(specialCellModuleID)){
+            for(auto centerNNN : getNNN(specialCellModuleID)){
                 std::cout << TString::Format(" NNN ID %d (x,y) (%.2f, %.2f)",
                              centerNNN,getCellCenterAbsolute(centerNNN).first,getCellCenterAbsolute(centerNNN).second) << std::endl;
             }
@@ -228,6 +345,152 @@ namespace ldmx {
         return;
     }
 
+    void EcalHexReadout::buildLatticeTable(){
+        // the lattice spans the module with a margin, so positions past the edge cells map to -1
+        latticeHalfWidth_ = nCellsWide_;
+        long width = 2*latticeHalfWidth_+1;
+        latticeCells_.assign(width*width, -1);
+        useLattice_ = true;
+        for(auto const& cell : cellPositionMap_) {
+            double x = cell.second.first;
+            double y = cell.second.second;
+            double r = (2./3.)*y/cellR_;
+            double q = (x*(sqrt(3.)/3.) - y/3.)/cellR_;
+            long column = lround(q) + latticeHalfWidth_;
+            long row = lround(r) + latticeHalfWidth_;
+            bool onLattice = (fabs(q - lround(q)) < 1E-3 && fabs(r - lround(r)) < 1E-3);
+            if(!onLattice || column < 0 || row < 0 || column >= width || row >= width || latticeCells_[row*width+column] >= 0) {
+                if(verbose_>0) std::cout << "[buildLatticeTable] Cell " << cell.first << " isn't on the lattice, using the TH2Poly search." << std::endl;
+                useLattice_ = false;
+                latticeCells_.clear();
+                return;
+            }
+            latticeCells_[row*width+column] = cell.first;
+        }
+    }
+
+    void EcalHexReadout::setNeighbors(const std::map<int, std::vector<int> >& NNMap, const std::map<int, std::vector<int> >& NNNMap){
+        // the neighbors of each channel are kept sorted so isNN()/isNNN() can binary search them
+        int nChannels = channelIDs_.size();
+        neighborOffsets_.assign(1, 0);
+        nnEnds_.clear();
+        neighborIDs_.clear();
+        for(int index = 0 ; index < nChannels ; index++){
+            auto nn = NNMap.find(channelIDs_[index]);
+            if(nn != NNMap.end()) neighborIDs_.insert(neighborIDs_.end(), nn->second.begin(), nn->second.end());
+            std::sort(neighborIDs_.begin() + neighborOffsets_.back(), neighborIDs_.end());
+            nnEnds_.push_back(neighborIDs_.size());
+            auto nnn = NNNMap.find(channelIDs_[index]);
+            if(nnn != NNNMap.end()) neighborIDs_.insert(neighborIDs_.end(), nnn->second.begin(), nnn->second.end());
+            std::sort(neighborIDs_.begin() + nnEnds_.back(), neighborIDs_.end());
+            neighborOffsets_.push_back(neighborIDs_.size());
+        }
+    }
+
+    bool EcalHexReadout::readCache(const std::string& cacheFile){
+        std::ifstream in(cacheFile, std::ios::binary);
+        if(!in) return false;
+
+        // every read is checked before its value is used, so a truncated file is rejected
+        auto read = [&in](void* data, std::size_t size) {
+            in.read((char*)data, size);
+            return in.good();
+        };
+
+        unsigned magic{0}, version{0}, nCellsWide{0}, nCells{0}, nChannels{0};
+        double moduleMinR{0}, gap{0};
+        if(!read(&magic, sizeof(magic)) || !read(&version, sizeof(version)) || !read(&moduleMinR, sizeof(moduleMinR))
+                || !read(&gap, sizeof(gap)) || !read(&nCellsWide, sizeof(nCellsWide))
+                || magic != CACHE_MAGIC || version != CACHE_VERSION || moduleMinR != moduler_ || gap != gap_ || nCellsWide != nCellsWide_) {
+            if(verbose_>0) std::cout << "[readCache] " << cacheFile << " doesn't match this readout, rebuilding." << std::endl;
+            return false;
+        }
+
+        // the cells of a module fit in nCellsWide+1 rows and columns, and
+        // there is one channel per cell of each of the seven modules
+        if(!read(&nCells, sizeof(nCells)) || nCells == 0 || nCells > (nCellsWide_+1)*(nCellsWide_+1)) return false;
+        std::vector<double> cellXY(2*nCells);
+        if(!read(cellXY.data(), cellXY.size()*sizeof(double))) return false;
+        if(!read(&nChannels, sizeof(nChannels)) || nChannels != 7*nCells) return false;
+        auto isChannel = [nCells](int id) { return id >= 0 && id % 10 < 7 && unsigned(id/10) < nCells; };
+
+        std::map<int, std::vector<int> > nnMap, nnnMap;
+        for(unsigned iChannel = 0 ; iChannel < nChannels ; iChannel++){
+            int id{0};
+            unsigned nNN{0}, nNNN{0};
+            if(!read(&id, sizeof(id)) || !isChannel(id)) return false;
+            if(!read(&nNN, sizeof(nNN)) || nNN > nChannels) return false;
+            if(nNN > 0){
+                std::vector<int>& nn = nnMap[id];
+                nn.resize(nNN);
+                if(!read(nn.data(), nNN*sizeof(int)) || !std::all_of(nn.begin(), nn.end(), isChannel)) return false;
+            }
+            if(!read(&nNNN, sizeof(nNNN)) || nNNN > nChannels) return false;
+            if(nNNN > 0){
+                std::vector<int>& nnn = nnnMap[id];
+                nnn.resize(nNNN);
+                if(!read(nnn.data(), nNNN*sizeof(int)) || !std::all_of(nnn.begin(), nnn.end(), isChannel)) return false;
+            }
+        }
+
+        // the cells are corner-down hexagons, as built by TH2Poly::Honeycomb.
+        // bins are numbered in the order they are added, matching the cell IDs.
+        ecalMap_ = new TH2Poly();
+        double vertexDX[6] = {0., cellr_, cellr_, 0., -cellr_, -cellr_};
+        double vertexDY[6] = {-cellR_, -cellR_/2., cellR_/2., cellR_, cellR_/2., -cellR_/2.};
+        for(unsigned id = 0 ; id < nCells ; id++){
+            double x = cellXY[2*id];
+            double y = cellXY[2*id+1];
+            double vertexX[6], vertexY[6];
+            for(int iVertex = 0 ; iVertex < 6 ; iVertex++){
+                vertexX[iVertex] = x + vertexDX[iVertex];
+                vertexY[iVertex] = y + vertexDY[iVertex];
+            }
+            ecalMap_->AddBin(6, vertexX, vertexY);
+            cellPositionMap_[id] = XYCoords(x,y);
+        }
+        buildModuleMap();
+        buildCellModuleMap();
+        buildLatticeTable();
+        setNeighbors(nnMap, nnnMap);
+        if(verbose_>0) std::cout << "[readCache] Read " << nCells << " cells from " << cacheFile << std::endl;
+        return true;
+    }
+
+    void EcalHexReadout::writeCache(const std::string& cacheFile) const {
+        std::ofstream out(cacheFile, std::ios::binary);
+        if(!out) {
+            std::cerr << "[EcalHexReadout::writeCache] Unable to write cache file " << cacheFile << std::endl;
+            return;
+        }
+
+        unsigned nCells = cellPositionMap_.size();
+        unsigned nChannels = cellModulePositionMap_.size();
+        out.write((const char*)&CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        out.write((const char*)&CACHE_VERSION, sizeof(CACHE_VERSION));
+        out.write((const char*)&moduler_, sizeof(moduler_));
+        out.write((const char*)&gap_, sizeof(gap_));
+        out.write((const char*)&nCellsWide_, sizeof(nCellsWide_));
+
+        out.write((const char*)&nCells, sizeof(nCells));
+        for(auto const& cell : cellPositionMap_){
+            out.write((const char*)&cell.second.first, sizeof(double));
+            out.write((const char*)&cell.second.second, sizeof(double));
+        }
+
+        out.write((const char*)&nChannels, sizeof(nChannels));
+        for(auto const& channel : cellModulePositionMap_){
+            IDRange nnIDs = getNN(channel.first);
+            IDRange nnnIDs = getNNN(channel.first);
+            unsigned nNN = nnIDs.size(), nNNN = nnnIDs.size();
+            out.write((const char*)&channel.first, sizeof(int));
+            out.write((const char*)&nNN, sizeof(nNN));
+            out.write((const char*)nnIDs.begin(), nNN*sizeof(int));
+            out.write((const char*)&nNNN, sizeof(nNNN));
+            out.write((const char*)nnnIDs.begin(), nNNN*sizeof(int));
+        }
+    }
+
     double EcalHexReadout::distanceToEdge(int cellModuleID) const {
         // https://math.stackexchange.com/questions/1210572/find-the-distance-to-the-edge-of-a-hexagon
         int cellID = separateID(cellModuleID).first;
@@ -0,0 +1,22 @@
+#include "DetDescr/IDCodec.h"
+
+namespace ldmx {
+
+    IDCodec::IDCodec(const IDField::IDFieldList& fieldList) {
+        fields_.resize(fieldList.size());
+        for (IDField* field : fieldList) {
+            Field& layout = fields_.at(field->getIndex());
+            layout.name = field->getFieldName();
+            layout.startBit = field->getStartBit();
+            layout.mask = field->getBitMask();
+        }
+    }
+
+    int IDCodec::getFieldIndex(const std::string& fieldName) const {
+        for (unsigned i = 0; i < fields_.size(); ++i) {
+            if (fields_[i].name == fieldName) return i;
+        }
+        return -1;
+    }
+
+}
@@ -0,0 +1,68 @@
+/**
+ * @file ldmx_make_conditions.cxx
+ * @brief Converts a CSV table of channel conditions into a binary conditions
+ *        file which can be memory-mapped by ChannelConditions.
+ *
+ * The CSV has one line per channel with the columns
+ *     index,gain,pedestal,noise,flags
+ * where index is the dense channel index used by the digi producer and
+ * flags is a sum of ChannelCondition::DEAD (1) and ChannelCondition::HOT (2).
+ * Empty lines, lines starting with '#' and a header line starting with
+ * "index" are skipped.  Channels without a line get the default conditions.
+ */
+
+#include "DetDescr/ChannelConditions.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+using ldmx::ChannelCondition;
+using ldmx::ChannelConditions;
+
+int main(int argc, const char* argv[]) {
+
+    if (argc != 3) {
+        std::cerr << "Usage: ldmx-make-conditions <input.csv> <output.bin>" << std::endl;
+        return 1;
+    }
+
+    std::ifstream in(argv[1]);
+    if (!in) {
+        std::cerr << "Unable to read " << argv[1] << std::endl;
+        return 1;
+    }
+
+    std::vector<ChannelCondition> channels;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        if (line.empty() || line[0] == '#' || line.compare(0, 5, "index") == 0) continue;
+
+        std::istringstream fields(line);
+        unsigned index;
+        ChannelCondition condition;
+        char c1, c2, c3, c4;
+        if (!(fields >> index >> c1 >> condition.gain >> c2 >> condition.pedestal
+                    >> c3 >> condition.noise >> c4 >> condition.flags)
+                || c1 != ',' || c2 != ',' || c3 != ',' || c4 != ',') {
+            std::cerr << "Bad conditions on line " << lineNumber << ": " << line << std::endl;
+            return 1;
+        }
+
+        if (index >= channels.size()) channels.resize(index + 1);
+        channels[index] = condition;
+    }
+
+    try {
+        ChannelConditions::write(argv[2], channels);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Wrote the conditions of " << channels.size() << " channels to " << argv[2] << std::endl;
+    return 0;
+}
@@ -0,0 +1,92 @@
+// LDMX
+#include "DetDescr/ChannelConditions.h"
+
+// STL
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using ldmx::ChannelCondition;
+using ldmx::ChannelConditions;
+
+int main(int, const char* argv[])  {
+
+    std::cout << "Hello ChannelConditions test!" << std::endl;
+
+    const std::string fileName = "channel_conditions_test.bin";
+
+    std::vector<ChannelCondition> channels(1000);
+    for (unsigned i = 0; i < channels.size(); ++i) {
+        channels[i].gain = 1 + 0.001*i;
+        channels[i].pedestal = 0.5*i;
+        channels[i].noise = 0.01*i;
+        if (i%100 == 7) channels[i].flags = ChannelCondition::DEAD;
+        if (i%100 == 8) channels[i].flags = ChannelCondition::HOT;
+    }
+    ChannelConditions::write(fileName, channels);
+
+    /*
+     * Check the mapped conditions against the ones written.
+     */
+    {
+        ChannelConditions conditions(fileName);
+        if (conditions.getNumChannels() != channels.size()) {
+            throw std::runtime_error("Wrong number of channels: " + std::to_string(conditions.getNumChannels()));
+        }
+        for (unsigned i = 0; i < channels.size(); ++i) {
+            const ChannelCondition& condition = conditions.get(i);
+            if (condition.gain != channels[i].gain || condition.pedestal != channels[i].pedestal
+                    || condition.noise != channels[i].noise || condition.flags != channels[i].flags) {
+                throw std::runtime_error("Wrong conditions for channel " + std::to_string(i));
+            }
+            if (condition.isMasked() != (i%100 == 7 || i%100 == 8)) {
+                throw std::runtime_error("Wrong mask for channel " + std::to_string(i));
+            }
+        }
+
+        // Channels beyond the table have the default conditions.
+        const ChannelCondition& outside = conditions.get(channels.size());
+        if (outside.gain != 1 || outside.pedestal != 0 || outside.noise >= 0 || outside.isMasked()) {
+            throw std::runtime_error("Wrong default conditions");
+        }
+        std::cout << "mapped conditions okay" << std::endl;
+    }
+
+    /*
+     * Check that the shared instances are mapped once per file.
+     */
+    const ChannelConditions& shared = ChannelConditions::getInstance(fileName);
+    if (&shared != &ChannelConditions::getInstance(fileName) || shared.get(10).pedestal != 5) {
+        throw std::runtime_error("Wrong shared conditions");
+    }
+    if (ChannelConditions::getInstance("").getNumChannels() != 0) {
+        throw std::runtime_error("The default conditions aren't empty");
+    }
+    std::cout << "shared conditions okay" << std::endl;
+
+    /*
+     * Check that a file which isn't a conditions file is rejected.
+     */
+    const std::string badFileName = "channel_conditions_test.csv";
+    {
+        std::ofstream bad(badFileName);
+        bad << "index,gain,pedestal,noise,flags" << std::endl;
+    }
+    bool rejected = false;
+    try {
+        ChannelConditions conditions(badFileName);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    std::remove(badFileName.c_str());
+    std::remove(fileName.c_str());
+    if (!rejected) {
+        throw std::runtime_error("A bad conditions file was accepted");
+    }
+    std::cout << "bad file rejected okay" << std::endl;
+
+    std::cout << "Bye ChannelConditions test!" << std::endl;
+}
@@ -0,0 +1,127 @@
+// LDMX
+#include "DetDescr/DefaultDetectorID.h"
+#include "DetDescr/DetectorIDStore.h"
+#include "DetDescr/EcalDetectorID.h"
+#include "DetDescr/HcalID.h"
+
+// STL
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ldmx::DetectorIDStore;
+using ldmx::EcalDetectorID;
+using ldmx::HcalID;
+using ldmx::IDCodec;
+
+/*
+ * Pack and unpack IDs with the codecs from the store, counting the IDs which
+ * don't match the static codecs.
+ */
+void packIDs(int seed, int nIDs, std::atomic<int>& nErrors) {
+
+    DetectorIDStore* store = DetectorIDStore::getInstance();
+
+    for (int i = 0; i < nIDs; ++i) {
+
+        const IDCodec* ecalCodec = store->getCodec("EcalID");
+        const IDCodec* hcalCodec = store->getCodec("HcalID");
+        if (!ecalCodec || !hcalCodec) {
+            ++nErrors;
+            continue;
+        }
+
+        unsigned layer = (seed + i)%34;
+        unsigned module = (seed*7 + i)%7;
+        unsigned cell = (seed*13 + i)%432;
+        IDCodec::RawValue ecalRawID = ecalCodec->encode(ecalCodec->encode(0, 0, 1), 1, layer);
+        ecalRawID = ecalCodec->encode(ecalCodec->encode(ecalRawID, 2, module), 3, cell);
+        if (ecalRawID != EcalDetectorID::encode(1, layer, module, cell)
+                || ecalCodec->decode(ecalRawID, 3) != cell) {
+            ++nErrors;
+        }
+
+        unsigned section = (seed + i)%5;
+        unsigned strip = (seed*3 + i)%256;
+        IDCodec::RawValue hcalRawID = hcalCodec->encode(hcalCodec->encode(0, 0, 5), 1, layer);
+        hcalRawID = hcalCodec->encode(hcalCodec->encode(hcalRawID, 2, section), 3, strip);
+        if (hcalRawID != HcalID::encode(5, layer, section, strip)
+                || hcalCodec->decode(hcalRawID, 2) != section) {
+            ++nErrors;
+        }
+    }
+}
+
+int main(int, const char* argv[])  {
+
+    std::cout << "Hello DetectorIDStore test!" << std::endl;
+
+    DetectorIDStore* store = DetectorIDStore::getInstance();
+    store->addID("EcalID", new EcalDetectorID());
+    store->addID("HcalID", new HcalID());
+
+    if (store->getCodec("NoSuchID") || store->getID("NoSuchID")) {
+        throw std::runtime_error("Found an ID which was never added");
+    }
+
+    const IDCodec* ecalCodec = store->getCodec("EcalID");
+    if (!ecalCodec || ecalCodec->getNumFields() != 4 || ecalCodec->getFieldIndex("cell") != 3) {
+        throw std::runtime_error("Wrong codec for EcalID");
+    }
+
+    // Pack IDs from many threads while another thread keeps adding IDs.
+    const int nThreads = 16;
+    const int nIDs = 20000;
+    std::atomic<int> nErrors{0};
+    std::vector<std::thread> threads;
+    for (int iThread = 0; iThread < nThreads; ++iThread) {
+        threads.push_back(std::thread(packIDs, iThread, nIDs, std::ref(nErrors)));
+    }
+    threads.push_back(std::thread([store]() {
+        for (int i = 0; i < 200; ++i) {
+            store->addID("ExtraID" + std::to_string(i), new EcalDetectorID());
+        }
+    }));
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    if (nErrors != 0) {
+        throw std::runtime_error(std::to_string(nErrors) + " IDs were packed wrongly");
+    } else {
+        std::cout << "packed " << nThreads*nIDs << " ECal and HCal IDs from " << nThreads << " threads okay" << std::endl;
+    }
+
+    if (store->getCodec("EcalID") != ecalCodec) {
+        throw std::runtime_error("The EcalID codec moved while IDs were added");
+    }
+    if (!store->getCodec("ExtraID199")) {
+        throw std::runtime_error("An ID added from another thread is missing");
+    }
+
+    // an ID can't be replaced under the same name
+    HcalID* duplicateID = new HcalID();
+    bool rejected = false;
+    try {
+        store->addID("EcalID", duplicateID);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    delete duplicateID;
+    if (!rejected || store->getCodec("EcalID") != ecalCodec) {
+        throw std::runtime_error("The EcalID was replaced");
+    }
+
+    // a codec ignores the fields it doesn't have, as DetectorID::pack does
+    IDCodec defaultCodec = ldmx::DefaultDetectorID().getCodec();
+    IDCodec::RawValue defaultRawID = defaultCodec.encode(defaultCodec.encode(0, 0, 2), 1, 5);
+    if (defaultCodec.getNumFields() != 2 || defaultCodec.encode(defaultRawID, 2, 3) != defaultRawID
+            || defaultCodec.decode(defaultRawID, 2) != 0 || defaultCodec.decode(defaultRawID, 1) != 5) {
+        throw std::runtime_error("A 2-field codec packed a field it doesn't have");
+    }
+
+    std::cout << "Bye DetectorIDStore test!" << std::endl;
+}
@@ -0,0 +1,155 @@
+// LDMX
+#include "DetDescr/EcalDetectorID.h"
+#include "DetDescr/HcalID.h"
+#include "DetDescr/TrackerID.h"
+
+// STL
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using ldmx::DetectorID;
+using ldmx::EcalDetectorID;
+using ldmx::HcalID;
+using ldmx::TrackerID;
+
+// The codecs are usable in constant expressions.
+static_assert(EcalDetectorID::encode(1, 33, 6, 431) == (1 | 33 << 4 | 6 << 12 | 431 << 15), "Wrong ECal encoding");
+static_assert(EcalDetectorID::CellField::decode(EcalDetectorID::encode(1, 33, 6, 431)) == 431, "Wrong ECal cell");
+static_assert(HcalID::StripField::replace(HcalID::encode(5, 80, 4, 33), 0) == HcalID::encode(5, 80, 4, 0), "Wrong HCal strip replace");
+
+void check(unsigned value, int expected, const std::string& name) {
+    if (value != unsigned(expected)) {
+        throw std::runtime_error("Wrong value for " + name + ": " + std::to_string(value)
+                + " (expected " + std::to_string(expected) + ")");
+    }
+}
+
+int main(int, const char* argv[])  {
+
+    std::cout << "Hello IDBitField test!" << std::endl;
+
+    /*
+     * Check that the static codecs agree with the runtime field maps.
+     */
+    EcalDetectorID ecalID;
+    for (int layer = 0; layer < 34; ++layer) {
+        for (int module = 0; module < 7; ++module) {
+            for (int cell = 0; cell < 432; cell += 7) {
+                ecalID.setFieldValue(0, 1);
+                ecalID.setFieldValue(1, layer);
+                ecalID.setFieldValue(2, module);
+                ecalID.setFieldValue(3, cell);
+                DetectorID::RawValue rawValue = ecalID.pack();
+                if (EcalDetectorID::encode(1, layer, module, cell) != rawValue) {
+                    throw std::runtime_error("ECal encoding does not match the runtime ID");
+                }
+                EcalDetectorID::Fields fields = EcalDetectorID::decode(rawValue);
+                check(fields.subdet, 1, "ECal subdet");
+                check(fields.layer, layer, "ECal layer");
+                check(fields.module, module, "ECal module");
+                check(fields.cell, cell, "ECal cell");
+            }
+        }
+    }
+    std::cout << "ECal codec okay" << std::endl;
+
+    HcalID hcalID;
+    for (int layer = 0; layer < 100; ++layer) {
+        for (int section = 0; section < 5; ++section) {
+            for (int strip = 0; strip < 256; strip += 5) {
+                hcalID.setFieldValue(0, 5);
+                hcalID.setFieldValue(1, layer);
+                hcalID.setFieldValue(2, section);
+                hcalID.setFieldValue(3, strip);
+                DetectorID::RawValue rawValue = hcalID.pack();
+                if (HcalID::encode(5, layer, section, strip) != rawValue) {
+                    throw std::runtime_error("HCal encoding does not match the runtime ID");
+                }
+                HcalID::Fields fields = HcalID::decode(rawValue);
+                check(fields.subdet, 5, "HCal subdet");
+                check(fields.layer, layer, "HCal layer");
+                check(fields.section, section, "HCal section");
+                check(fields.strip, strip, "HCal strip");
+            }
+        }
+    }
+
+    std::vector<DetectorID::RawValue> hcalRawValues;
+    for (int i = 0; i < 1000; ++i) {
+        hcalRawValues.push_back(HcalID::encode(5, i%100, i%5, i%256));
+    }
+    std::vector<unsigned> hcalLayers(1000), hcalSections(1000), hcalStrips(1000);
+    HcalID::decode(hcalRawValues.data(), hcalRawValues.size(), hcalLayers.data(), hcalSections.data(), hcalStrips.data());
+    for (int i = 0; i < 1000; ++i) {
+        check(hcalLayers[i], i%100, "batch HCal layer");
+        check(hcalSections[i], i%5, "batch HCal section");
+        check(hcalStrips[i], i%256, "batch HCal strip");
+    }
+    std::cout << "HCal codec okay" << std::endl;
+
+    TrackerID trackerID;
+    for (int layer = 0; layer < 20; ++layer) {
+        for (int module = 0; module < 32; ++module) {
+            trackerID.setFieldValue(0, 2);
+            trackerID.setFieldValue(1, layer);
+            trackerID.setFieldValue(2, module);
+            DetectorID::RawValue rawValue = trackerID.pack();
+            if (TrackerID::encode(2, layer, module) != rawValue) {
+                throw std::runtime_error("Tracker encoding does not match the runtime ID");
+            }
+            TrackerID::Fields fields = TrackerID::decode(rawValue);
+            check(fields.subdet, 2, "tracker subdet");
+            check(fields.layer, layer, "tracker layer");
+            check(fields.module, module, "tracker module");
+        }
+    }
+    std::cout << "Tracker codec okay" << std::endl;
+
+    /*
+     * Compare the decoding time of the runtime ID and the static codec.
+     */
+    std::vector<DetectorID::RawValue> rawValues;
+    for (int i = 0; i < 1000000; ++i) {
+        rawValues.push_back(EcalDetectorID::encode(1, i%34, i%7, i%432));
+    }
+
+    typedef std::chrono::high_resolution_clock Clock;
+    unsigned long sumRuntime = 0;
+    Clock::time_point start = Clock::now();
+    for (DetectorID::RawValue rawValue : rawValues) {
+        ecalID.setRawValue(rawValue);
+        ecalID.unpack();
+        sumRuntime += ecalID.getFieldValue("layer") + ecalID.getFieldValue("module_position") + ecalID.getFieldValue("cell");
+    }
+    double runtimeTime = std::chrono::duration<double, std::nano>(Clock::now() - start).count()/rawValues.size();
+
+    unsigned long sumStatic = 0;
+    start = Clock::now();
+    for (DetectorID::RawValue rawValue : rawValues) {
+        EcalDetectorID::Fields fields = EcalDetectorID::decode(rawValue);
+        sumStatic += fields.layer + fields.module + fields.cell;
+    }
+    double staticTime = std::chrono::duration<double, std::nano>(Clock::now() - start).count()/rawValues.size();
+
+    std::vector<unsigned> layers(rawValues.size()), modules(rawValues.size()), cells(rawValues.size());
+    start = Clock::now();
+    EcalDetectorID::decode(rawValues.data(), rawValues.size(), layers.data(), modules.data(), cells.data());
+    double batchTime = std::chrono::duration<double, std::nano>(Clock::now() - start).count()/rawValues.size();
+
+    unsigned long sumBatch = 0;
+    for (std::size_t i = 0; i < rawValues.size(); ++i) {
+        sumBatch += layers[i] + modules[i] + cells[i];
+    }
+
+    if (sumRuntime != sumStatic || sumRuntime != sumBatch) {
+        throw std::runtime_error("The runtime, static and batch decodings differ");
+    }
+    std::cout << "runtime ID decode: " << runtimeTime << " ns/ID" << std::endl;
+    std::cout << "static codec decode: " << staticTime << " ns/ID" << std::endl;
+    std::cout << "batch codec decode: " << batchTime << " ns/ID" << std::endl;
+
+    std::cout << "Bye IDBitField test!" << std::endl;
+}
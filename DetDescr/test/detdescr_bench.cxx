@@ -0,0 +1,290 @@
+/**
+ * @file detdescr_bench.cxx
+ * @brief Times the DetDescr geometry lookups and ID codecs, and checks the fast
+ *        ECal cell lookup against the TH2Poly reference.
+ *
+ * Any mismatch between a fast lookup and its reference is fatal, so a
+ * geometry speed-up can only be accepted if this program runs through.
+ */
+
+// LDMX
+#include "DetDescr/EcalDetectorID.h"
+#include "DetDescr/EcalHexReadout.h"
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using ldmx::DetectorID;
+using ldmx::EcalDetectorID;
+using ldmx::EcalHexReadout;
+using ldmx::IDRange;
+
+typedef std::chrono::high_resolution_clock Clock;
+
+/** @return The time since start [ns]. */
+double elapsed(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+/**
+ * Check that two readouts have the same channels, positions and neighbors.
+ */
+void compareReadouts(const EcalHexReadout& readout, const EcalHexReadout& reference) {
+    if (readout.getNumChannels() != reference.getNumChannels()) {
+        throw std::runtime_error("The cached readout has " + std::to_string(readout.getNumChannels()) + " channels instead of "
+                + std::to_string(reference.getNumChannels()));
+    }
+    for (int index = 0; index < reference.getNumChannels(); ++index) {
+        int id = reference.getCellModuleIDFromIndex(index);
+        if (readout.getCellModuleIDFromIndex(index) != id
+                || readout.getChannelX(index) != reference.getChannelX(index)
+                || readout.getChannelY(index) != reference.getChannelY(index)
+                || readout.getNN(id).toVector() != reference.getNN(id).toVector()
+                || readout.getNNN(id).toVector() != reference.getNNN(id).toVector()) {
+            throw std::runtime_error("The cached readout differs for cellModuleID " + std::to_string(id));
+        }
+    }
+}
+
+int main(int, const char* argv[])  {
+
+    std::cout << "Hello DetDescr benchmark!" << std::endl;
+
+    /*
+     * Time building the ECal readout from scratch and from a cache file.
+     */
+    const int nBuilds = 5;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < nBuilds; ++i) {
+        EcalHexReadout readout;
+    }
+    double buildTime = elapsed(start)/nBuilds;
+
+    const std::string cacheFile = "detdescr_bench_hexreadout.cache";
+    std::remove(cacheFile.c_str());
+    EcalHexReadout reference(EcalHexReadout::defaultMinR, EcalHexReadout::defaultGap_, EcalHexReadout::defaultNCellsWide, cacheFile);
+    start = Clock::now();
+    for (int i = 0; i < nBuilds; ++i) {
+        EcalHexReadout readout(EcalHexReadout::defaultMinR, EcalHexReadout::defaultGap_, EcalHexReadout::defaultNCellsWide, cacheFile);
+        if (i == 0) compareReadouts(readout, reference);
+    }
+    double cachedBuildTime = elapsed(start)/nBuilds;
+    std::remove(cacheFile.c_str());
+
+    std::cout << "EcalHexReadout build: " << buildTime/1E6 << " ms" << std::endl;
+    std::cout << "EcalHexReadout build from cache: " << cachedBuildTime/1E6 << " ms" << std::endl;
+
+    const EcalHexReadout& hexReadout = EcalHexReadout::getInstance();
+    int nChannels = hexReadout.getNumChannels();
+
+    // runs with the default ECal geometry share the default readout, and
+    // runs without stored parameters need a known detector
+    if (&EcalHexReadout::getInstance(EcalHexReadout::getRunGeometry("no-such-detector", 85., 0.)) != &hexReadout
+            || &EcalHexReadout::getInstance(EcalHexReadout::getRunGeometry("ldmx-det-full-v4-fieldmap-magnet", 0., 0.)) != &hexReadout) {
+        throw std::runtime_error("Wrong readout for a run");
+    }
+    bool rejected = false;
+    try {
+        EcalHexReadout::getRunGeometry("no-such-detector", 0., 0.);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    if (!rejected) {
+        throw std::runtime_error("A run of an unknown detector without parameters was accepted");
+    }
+    double cellMinR = hexReadout.getCellMinMaxRadii()[0];
+    double moduleMaxR = hexReadout.getModuleMinMaxRadii()[1];
+
+    /*
+     * Check the cell lookup against the TH2Poly search on a dense grid over a
+     * module, including the area outside of it. The grid is offset by an
+     * irrational fraction of its step so no point lies exactly on a cell edge.
+     */
+    double step = cellMinR/20;
+    double extent = 1.05*moduleMaxR;
+    std::vector<double> gridX, gridY;
+    for (double x = -extent + step*(sqrt(2.) - 1); x < extent; x += step) {
+        for (double y = -extent + step*(sqrt(3.) - 1); y < extent; y += step) {
+            gridX.push_back(x);
+            gridY.push_back(y);
+        }
+    }
+    std::size_t nGrid = gridX.size();
+
+    std::vector<int> referenceIDs(nGrid), fastIDs(nGrid);
+    start = Clock::now();
+    for (std::size_t i = 0; i < nGrid; ++i) {
+        referenceIDs[i] = hexReadout.getPolyCellIDRelative(gridX[i], gridY[i]);
+    }
+    double referenceTime = elapsed(start)/nGrid;
+
+    start = Clock::now();
+    for (std::size_t i = 0; i < nGrid; ++i) {
+        try {
+            fastIDs[i] = hexReadout.getCellIDRelative(gridX[i], gridY[i]);
+        } catch (const std::invalid_argument&) {
+            fastIDs[i] = -1;
+        }
+    }
+    double fastTime = elapsed(start)/nGrid;
+
+    int nMismatches = 0;
+    for (std::size_t i = 0; i < nGrid; ++i) {
+        int referenceID = referenceIDs[i] < 0 ? -1 : referenceIDs[i];
+        if (fastIDs[i] != referenceID) {
+            if (++nMismatches <= 10) {
+                std::cout << "cell " << fastIDs[i] << " instead of " << referenceID
+                          << " at (" << gridX[i] << ", " << gridY[i] << ")" << std::endl;
+            }
+        }
+    }
+    if (nMismatches != 0) {
+        throw std::runtime_error(std::to_string(nMismatches) + " of " + std::to_string(nGrid)
+                + " grid points are in the wrong cell");
+    }
+    std::cout << "cell lookup matches TH2Poly at " << nGrid << " grid points" << std::endl;
+    std::cout << "TH2Poly cell lookup: " << referenceTime << " ns/point" << std::endl;
+    std::cout << "getCellIDRelative: " << fastTime << " ns/point" << std::endl;
+
+    /*
+     * Time the absolute lookup of random points, each within the inner circle
+     * of a random cell so the expected ID is known.
+     */
+    const int nPoints = 1000000;
+    std::mt19937 generator(20190501);
+    std::uniform_int_distribution<int> channelDistribution(0, nChannels - 1);
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    std::vector<double> pointX(nPoints), pointY(nPoints);
+    std::vector<int> expectedIDs(nPoints);
+    for (int i = 0; i < nPoints; ++i) {
+        int index = channelDistribution(generator);
+        double radius = 0.9*cellMinR*sqrt(uniform(generator));
+        double angle = 2*M_PI*uniform(generator);
+        pointX[i] = hexReadout.getChannelX(index) + radius*cos(angle);
+        pointY[i] = hexReadout.getChannelY(index) + radius*sin(angle);
+        expectedIDs[i] = hexReadout.getCellModuleIDFromIndex(index);
+    }
+
+    std::vector<int> cellModuleIDs(nPoints);
+    start = Clock::now();
+    for (int i = 0; i < nPoints; ++i) {
+        cellModuleIDs[i] = hexReadout.getCellModuleID(pointX[i], pointY[i]);
+    }
+    double lookupTime = elapsed(start)/nPoints;
+    if (cellModuleIDs != expectedIDs) {
+        throw std::runtime_error("getCellModuleID found the wrong cell for a random point");
+    }
+    std::cout << "getCellModuleID: " << lookupTime << " ns/point" << std::endl;
+
+    /*
+     * Check the neighbors against a scan over all pairs of cells, with the
+     * distances used by EcalHexReadout::buildNeighborMaps().
+     */
+    for (int index = 0; index < nChannels; ++index) {
+        std::vector<int> nn, nnn;
+        for (int probe = 0; probe < nChannels; ++probe) {
+            double dX = hexReadout.getChannelX(probe) - hexReadout.getChannelX(index);
+            double dY = hexReadout.getChannelY(probe) - hexReadout.getChannelY(index);
+            double dist = sqrt(dX*dX + dY*dY);
+            if (dist > 1*cellMinR && dist <= 3.*cellMinR) nn.push_back(hexReadout.getCellModuleIDFromIndex(probe));
+            else if (dist > 3.*cellMinR && dist <= 4.5*cellMinR) nnn.push_back(hexReadout.getCellModuleIDFromIndex(probe));
+        }
+        std::sort(nn.begin(), nn.end());
+        std::sort(nnn.begin(), nnn.end());
+        int id = hexReadout.getCellModuleIDFromIndex(index);
+        if (hexReadout.getNN(id).toVector() != nn || hexReadout.getNNN(id).toVector() != nnn) {
+            throw std::runtime_error("Wrong neighbors for cellModuleID " + std::to_string(id));
+        }
+    }
+    std::cout << "neighbors of " << nChannels << " cells match the all-pairs scan" << std::endl;
+
+    /*
+     * Time the neighbor queries.
+     */
+    std::vector<int> centerIDs(nPoints), probeIDs(nPoints);
+    for (int i = 0; i < nPoints; ++i) {
+        centerIDs[i] = hexReadout.getCellModuleIDFromIndex(channelDistribution(generator));
+        IDRange nn = hexReadout.getNN(centerIDs[i]);
+        // probe a neighbor half of the time
+        probeIDs[i] = (i%2 == 0 && !nn.empty()) ? nn[i%nn.size()] : cellModuleIDs[i];
+    }
+
+    unsigned long nNeighbors = 0;
+    start = Clock::now();
+    for (int i = 0; i < nPoints; ++i) {
+        nNeighbors += hexReadout.getNN(centerIDs[i]).size() + hexReadout.getNNN(centerIDs[i]).size();
+    }
+    double neighborTime = elapsed(start)/nPoints;
+
+    unsigned long nFound = 0;
+    start = Clock::now();
+    for (int i = 0; i < nPoints; ++i) {
+        nFound += hexReadout.isNN(centerIDs[i], probeIDs[i]) + hexReadout.isNNN(centerIDs[i], probeIDs[i]);
+    }
+    double isNeighborTime = elapsed(start)/nPoints;
+
+    std::cout << "getNN + getNNN: " << neighborTime << " ns/cell (" << nNeighbors << " neighbors)" << std::endl;
+    std::cout << "isNN + isNNN: " << isNeighborTime << " ns/pair (" << nFound << " found)" << std::endl;
+
+    /*
+     * Time packing and unpacking ECal IDs with the runtime fields and with the
+     * static codec.
+     */
+    EcalDetectorID ecalID;
+    std::vector<DetectorID::RawValue> runtimeRawValues(nPoints);
+    start = Clock::now();
+    for (int i = 0; i < nPoints; ++i) {
+        ecalID.setFieldValue(0, 1);
+        ecalID.setFieldValue(1, i%34);
+        ecalID.setFieldValue(2, cellModuleIDs[i]%10);
+        ecalID.setFieldValue(3, cellModuleIDs[i]/10);
+        runtimeRawValues[i] = ecalID.pack();
+    }
+    double runtimePackTime = elapsed(start)/nPoints;
+
+    std::vector<DetectorID::RawValue> staticRawValues(nPoints);
+    start = Clock::now();
+    for (int i = 0; i < nPoints; ++i) {
+        staticRawValues[i] = EcalDetectorID::encode(1, i%34, cellModuleIDs[i]%10, cellModuleIDs[i]/10);
+    }
+    double staticPackTime = elapsed(start)/nPoints;
+
+    if (runtimeRawValues != staticRawValues) {
+        throw std::runtime_error("The runtime and static ECal IDs differ");
+    }
+
+    unsigned long sumRuntime = 0;
+    start = Clock::now();
+    for (DetectorID::RawValue rawValue : runtimeRawValues) {
+        ecalID.setRawValue(rawValue);
+        ecalID.unpack();
+        sumRuntime += ecalID.getFieldValue("layer") + ecalID.getFieldValue("module_position") + ecalID.getFieldValue("cell");
+    }
+    double runtimeUnpackTime = elapsed(start)/nPoints;
+
+    unsigned long sumStatic = 0;
+    start = Clock::now();
+    for (DetectorID::RawValue rawValue : staticRawValues) {
+        EcalDetectorID::Fields fields = EcalDetectorID::decode(rawValue);
+        sumStatic += fields.layer + fields.module + fields.cell;
+    }
+    double staticUnpackTime = elapsed(start)/nPoints;
+
+    if (sumRuntime != sumStatic) {
+        throw std::runtime_error("The runtime and static ECal decodings differ");
+    }
+    std::cout << "runtime ID pack: " << runtimePackTime << " ns/ID" << std::endl;
+    std::cout << "static codec pack: " << staticPackTime << " ns/ID" << std::endl;
+    std::cout << "runtime ID unpack: " << runtimeUnpackTime << " ns/ID" << std::endl;
+    std::cout << "static codec unpack: " << staticUnpackTime << " ns/ID" << std::endl;
+
+    std::cout << "Bye DetDescr benchmark!" << std::endl;
+}
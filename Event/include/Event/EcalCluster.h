@@ -0,0 +1,128 @@
+/**
+ * @file EcalCluster.h
+ * @brief Class that stores a cluster of neighboring ECal hits
+ */
+
+#ifndef EVENT_ECALCLUSTER_H_
+#define EVENT_ECALCLUSTER_H_
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <iostream>
+#include <vector>
+
+//----------//
+//   ROOT   //
+//----------//
+#include <TObject.h>
+
+namespace ldmx {
+
+    /**
+     * @class EcalCluster
+     * @brief Stores a cluster of neighboring ECal hits
+     *
+     * @note
+     * The hits of the cluster are identified by their index in the ECal 
+     * digi collection the cluster was built from.  The centroid and the 
+     * mean layer are weighted by the hit energies.
+     */
+    class EcalCluster : public TObject {
+
+        public:
+
+            /** Constructor */
+            EcalCluster();
+
+            /** Destructor */
+            ~EcalCluster();
+
+            /** Reset the object. */
+            void Clear(Option_t *option = "");
+
+            /** Copy this object. */
+            void Copy(TObject& object) const;
+
+            /** Print out the object. */
+            void Print(Option_t *option = "") const;
+
+            /** Get the energy of the cluster [MeV]. */
+            float getEnergy() const { return energy_; }
+
+            /** Get the number of hits in the cluster. */
+            int getNumHits() const { return hitIndices_.size(); }
+
+            /** Get the index of the ith hit of the cluster. */
+            int getHitIndex(int i) const { return hitIndices_[i]; }
+
+            /** Get the index of the hit with the most energy. */
+            int getSeedIndex() const { return seedIndex_; }
+
+            /** Get the energy weighted x position of the cluster [mm]. */
+            float getCentroidX() const { return centroidX_; }
+
+            /** Get the energy weighted y position of the cluster [mm]. */
+            float getCentroidY() const { return centroidY_; }
+
+            /** Get the energy weighted mean layer of the cluster. */
+            float getMeanLayer() const { return meanLayer_; }
+
+            /** Get the first layer with a hit in the cluster. */
+            int getFirstLayer() const { return firstLayer_; }
+
+            /** Get the last layer with a hit in the cluster. */
+            int getLastLayer() const { return lastLayer_; }
+
+            /** Add a hit, given by its index, to the cluster. */
+            void addHitIndex(int index) { hitIndices_.push_back(index); }
+
+            /** Set the energy of the cluster [MeV]. */
+            void setEnergy(float energy) { energy_ = energy; }
+
+            /** Set the index of the hit with the most energy. */
+            void setSeedIndex(int index) { seedIndex_ = index; }
+
+            /** Set the energy weighted position of the cluster [mm]. */
+            void setCentroidXY(float x, float y) { centroidX_ = x; centroidY_ = y; }
+
+            /** Set the energy weighted mean layer of the cluster. */
+            void setMeanLayer(float layer) { meanLayer_ = layer; }
+
+            /** Set the first and last layers with a hit in the cluster. */
+            void setLayerRange(int firstLayer, int lastLayer) { 
+                firstLayer_ = firstLayer; 
+                lastLayer_ = lastLayer; 
+            }
+
+        private:
+
+            /** Energy of the cluster [MeV]. */
+            float energy_{0};
+
+            /** Energy weighted x position [mm]. */
+            float centroidX_{0};
+
+            /** Energy weighted y position [mm]. */
+            float centroidY_{0};
+
+            /** Energy weighted mean layer. */
+            float meanLayer_{0};
+
+            /** First layer with a hit. */
+            int firstLayer_{-1};
+
+            /** Last layer with a hit. */
+            int lastLayer_{-1};
+
+            /** Index of the hit with the most energy. */
+            int seedIndex_{-1};
+
+            /** Indices of the hits of the cluster. */
+            std::vector<int> hitIndices_;
+
+        ClassDef(EcalCluster, 1);
+    };
+}
+
+#endif // EVENT_ECALCLUSTER_H_
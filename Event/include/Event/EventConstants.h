@@ -36,6 +36,7 @@ namespace ldmx {
             static const std::string TARGET_SIM_HITS;
             static const std::string TRIGGER_PAD_SIM_HITS;
             static const std::string TRIGGER_RESULT;
+            static const std::string TRUTH_SUMMARY;
 
             /*
              * Type names, mostly for initializing clones arrays.
@@ -48,6 +49,12 @@ namespace ldmx {
             static const std::string RUN_HEADER;
             static const std::string PN_WEIGHT;
 
+            /*
+             * Run header parameter names.
+             */
+            static const std::string ECAL_HEX_RADIUS;
+            static const std::string ECAL_HEX_GAP;
+
     }; // class EventConstants
 
 } // namespace event
@@ -21,3 +21,6 @@
 #include "Event/PnWeightResult.h"
 #include "Event/SiStripHit.h"
 #include "Event/RawHit.h"
+#include "Event/SortedHitIndices.h"
+#include "Event/TruthSummary.h"
+#include "Event/EcalCluster.h"
@@ -19,6 +19,7 @@
 #pragma link C++ class ldmx::CalorimeterHit+;
 #pragma link C++ class ldmx::HcalHit+;
 #pragma link C++ class ldmx::HcalVetoResult+;
+#pragma link C++ class ldmx::EcalCluster+;
 #pragma link C++ class ldmx::EcalHit+;
 #pragma link C++ class ldmx::EcalVetoResult+;
 #pragma link C++ class ldmx::EventConstants+;
@@ -32,6 +33,8 @@
 #pragma link C++ class ldmx::PnWeightResult+;
 #pragma link C++ class ldmx::SiStripHit+; 
 #pragma link C++ class ldmx::RawHit+; 
+#pragma link C++ class ldmx::SortedHitIndices+;
+#pragma link C++ class ldmx::TruthSummary+;
 
 #endif
 
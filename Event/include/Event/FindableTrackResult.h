@@ -87,6 +87,26 @@ namespace ldmx {
              */
             bool is3sFindable() { return is3sFindable_; };
 
+            /**
+             * Checks if a sim particle is findable using the nth strategy 
+             * configured in FindableTrackProcessor.
+             *
+             * @param strategy The index of the strategy.
+             */
+            bool isFindable(int strategy) const { return (findableMask_ >> strategy) & 1u; };
+
+            /**
+             * Get the bit mask of the configured strategies which can find
+             * the sim particle. 
+             */
+            unsigned int getFindableMask() const { return findableMask_; };
+
+            /**
+             * Set the bit mask of the configured strategies which can find
+             * the sim particle. 
+             */
+            void setFindableMask(unsigned int findableMask) { findableMask_ = findableMask; };
+
             /**
              * Get the sim particle associated with this result.
              */
@@ -150,7 +170,13 @@ namespace ldmx {
              */
             bool is3sFindable_{false}; 
 
-        ClassDef(FindableTrackResult, 3); 
+            /**
+             * Bit mask whose nth bit is set if the particle is findable using
+             * the nth strategy configured in FindableTrackProcessor.
+             */
+            unsigned int findableMask_{0};
+
+        ClassDef(FindableTrackResult, 4); 
 
     }; // FindableTrackResult
 }
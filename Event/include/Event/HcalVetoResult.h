@@ -36,6 +36,23 @@ namespace ldmx {
              */
             void setResult(bool passesVeto) { passesVeto_ = passesVeto; };
 
+            /**
+             * Set the PE sums used by the veto.
+             *
+             * @param backPE Total PE of the in-time back Hcal hits.
+             * @param sidePE Total PE of the in-time side Hcal hits.
+             * @param maxPE Largest PE of a single in-time hit.
+             * @param outOfTimePE Total PE of the hits outside the time window.
+             * @param maxPEHitID ID of the in-time hit with the largest PE.
+             */
+            void setPESums(float backPE, float sidePE, float maxPE, float outOfTimePE, int maxPEHitID) { 
+                backPE_ = backPE; 
+                sidePE_ = sidePE; 
+                maxPE_ = maxPE; 
+                outOfTimePE_ = outOfTimePE; 
+                maxPEHitID_ = maxPEHitID; 
+            }
+
             /** Copy the object */
             void Copy(TObject& object) const; 
 
@@ -48,12 +65,45 @@ namespace ldmx {
             /** Checks if the event passes the Hcal veto. */
             bool passesVeto() { return passesVeto_; };
 
+            /** Get the total PE of the in-time Hcal hits. */
+            float getTotalPE() const { return backPE_ + sidePE_; };
+
+            /** Get the total PE of the in-time back Hcal hits. */
+            float getBackPE() const { return backPE_; };
+
+            /** Get the total PE of the in-time side Hcal hits. */
+            float getSidePE() const { return sidePE_; };
+
+            /** Get the largest PE of a single in-time hit. */
+            float getMaxPE() const { return maxPE_; };
+
+            /** Get the total PE of the hits outside the time window. */
+            float getOutOfTimePE() const { return outOfTimePE_; };
+
+            /** Get the ID of the in-time hit with the largest PE. */
+            int getMaxPEHitID() const { return maxPEHitID_; };
+
         private:
            
             /** Flag indicating whether the event passes the Hcal veto. */
             bool passesVeto_{false};
 
-        ClassDef(HcalVetoResult, 1); 
+            /** Total PE of the in-time back Hcal hits. */
+            float backPE_{0};
+
+            /** Total PE of the in-time side Hcal hits. */
+            float sidePE_{0};
+
+            /** Largest PE of a single in-time hit. */
+            float maxPE_{0};
+
+            /** Total PE of the hits outside the time window. */
+            float outOfTimePE_{0};
+
+            /** ID of the in-time hit with the largest PE. */
+            int maxPEHitID_{0};
+
+        ClassDef(HcalVetoResult, 2); 
 
     }; // HcalVetoResult
 }
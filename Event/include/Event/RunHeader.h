@@ -90,10 +90,11 @@ namespace ldmx {
             /**
              * Get an int parameter value.
              * @param name The name of the parameter.
-             * @return The parameter value.
+             * @return The parameter value, or 0 if it isn't set.
              */
-            int getIntParameter(const std::string& name) {
-                return intParameters_[name];
+            int getIntParameter(const std::string& name) const {
+                auto search = intParameters_.find(name);
+                return search == intParameters_.end() ? 0 : search->second;
             }
 
             /**
@@ -109,10 +110,11 @@ namespace ldmx {
             /**
              * Get a float parameter value.
              * @param name The name of the parameter.
-             * @return value The parameter value.
+             * @return value The parameter value, or 0 if it isn't set.
              */
-            float getFloatParameter(const std::string& name) {
-                return floatParameters_[name];
+            float getFloatParameter(const std::string& name) const {
+                auto search = floatParameters_.find(name);
+                return search == floatParameters_.end() ? 0 : search->second;
             }
 
             /**
@@ -127,10 +129,11 @@ namespace ldmx {
             /**
              * Get a string parameter value.
              * @param name The name of the parameter.
-             * @return value The parameter value.
+             * @return value The parameter value, or an empty string if it isn't set.
              */
-            std::string getStringParameter(const std::string& name) {
-                return stringParameters_[name];
+            std::string getStringParameter(const std::string& name) const {
+                auto search = stringParameters_.find(name);
+                return search == stringParameters_.end() ? "" : search->second;
             }
 
             /**
@@ -12,6 +12,7 @@
 //----------------------//
 #include <iostream>
 #include <string>
+#include <vector>
 
 //----------//
 //   ROOT   //
@@ -51,6 +52,52 @@ namespace ldmx {
              */ 
             TRefArray* getSimTrackerHits() { return simTrackerHits_; }
 
+            /** Get the layer ID of the sensor containing this hit. */
+            int getLayerID() const { return layerID_; }
+
+            /** Get the module ID of the sensor containing this hit. */
+            int getModuleID() const { return moduleID_; }
+
+            /** Get the index of the first strip in this hit. */
+            int getFirstStrip() const { return firstStrip_; }
+
+            /** Get the index of the last strip in this hit. */
+            int getLastStrip() const { return lastStrip_; }
+
+            /** Get the number of strips spanned by this hit. */
+            int getNumStrips() const { return lastStrip_ - firstStrip_ + 1; }
+
+            /** Get the charge of this hit, given as the deposited energy [MeV]. */
+            float getCharge() const { return charge_; }
+
+            /** Get the charge weighted position of this hit [mm]. */
+            std::vector<float> getPosition() const { return {x_, y_, z_}; }
+
+            /**
+             * Set the sensor containing this hit.
+             *
+             * @param layerID The layer ID of the sensor.
+             * @param moduleID The module ID of the sensor.
+             */
+            void setSensor(int layerID, int moduleID) { layerID_ = layerID; moduleID_ = moduleID; }
+
+            /**
+             * Set the range of strips spanned by this hit.
+             *
+             * @param firstStrip The index of the first strip.
+             * @param lastStrip The index of the last strip.
+             */
+            void setStrips(int firstStrip, int lastStrip) { firstStrip_ = firstStrip; lastStrip_ = lastStrip; }
+
+            /** Set the charge of this hit, given as the deposited energy [MeV]. */
+            void setCharge(float charge) { charge_ = charge; }
+
+            /** Set the charge weighted position of this hit [mm]. */
+            void setPosition(float x, float y, float z) { x_ = x; y_ = y; z_ = z; }
+
+            /** Set the time of this hit [ns]. */
+            void setTime(float time) { time_ = time; }
+
             /** Print a description of this object. */
             void Print(Option_t* option = "") const; 
 
@@ -64,9 +111,33 @@ namespace ldmx {
              * SiStripHit.  
              */
             TRefArray* simTrackerHits_{new TRefArray{}};
+
+            /** The layer ID of the sensor. */
+            int layerID_{-1};
+
+            /** The module ID of the sensor. */
+            int moduleID_{-1};
+
+            /** The index of the first strip. */
+            int firstStrip_{0};
+
+            /** The index of the last strip. */
+            int lastStrip_{-1};
+
+            /** The charge, given as the deposited energy [MeV]. */
+            float charge_{0};
+
+            /** The charge weighted x position [mm]. */
+            float x_{0};
+
+            /** The charge weighted y position [mm]. */
+            float y_{0};
+
+            /** The charge weighted z position [mm]. */
+            float z_{0};
             
             /** Class declaration */ 
-            ClassDef(SiStripHit, 1);
+            ClassDef(SiStripHit, 2);
             
     }; // SiStripHit
 }
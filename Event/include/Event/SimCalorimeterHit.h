@@ -39,6 +39,7 @@ namespace ldmx {
              */
             struct Contrib {
                 SimParticle* particle{nullptr};
+                int trackID{-1};
                 int pdgCode{0};
                 float edep{0};
                 float time{0};
@@ -104,6 +105,30 @@ namespace ldmx {
                 return {x_, y_, z_};
             }
 
+            /**
+             * Get the X position of the hit [mm].
+             * @return The X position of the hit.
+             */
+            float getX() const {
+                return x_;
+            }
+
+            /**
+             * Get the Y position of the hit [mm].
+             * @return The Y position of the hit.
+             */
+            float getY() const {
+                return y_;
+            }
+
+            /**
+             * Get the Z position of the hit [mm].
+             * @return The Z position of the hit.
+             */
+            float getZ() const {
+                return z_;
+            }
+
             /**
              * Set the XYZ position of the hit [mm].
              * @param x The X position.
@@ -146,8 +171,9 @@ namespace ldmx {
              * @param pdgCode The PDG code of the actual track.
              * @param edep The energy deposition of the hit [MeV].
              * @param time The time of the hit [ns].
+             * @param trackID The track ID of the particle, or -1 if unknown.
              */
-            void addContrib(SimParticle* simParticle, int pdgCode, float edep, float time);
+            void addContrib(SimParticle* simParticle, int pdgCode, float edep, float time, int trackID = -1);
 
             /**
              * Get a hit contribution by index.
@@ -156,6 +182,29 @@ namespace ldmx {
              */
             Contrib getContrib(int i);
 
+            /**
+             * Get the track ID of the particle which made a hit contribution.
+             * Unlike getContrib, this does not resolve the particle reference.
+             * @param i The index of the hit contribution.
+             * @return The track ID of the particle, or -1 if unknown.
+             */
+            int getContribTrackID(int i) const {
+                return i >= 0 && static_cast<std::size_t>(i) < trackIDContribs_.size() ? trackIDContribs_[i] : -1;
+            }
+
+            /**
+             * Check if a particle made any of the hit contributions by 
+             * comparing track IDs.  The search stops at the first match.
+             * @param trackID The track ID of the particle.
+             * @return True if the particle made a hit contribution.
+             */
+            bool hasContribFromTrack(int trackID) const {
+                for (int contribTrackID : trackIDContribs_) {
+                    if (contribTrackID == trackID) return true;
+                }
+                return false;
+            }
+
             /**
              * Find the index of a hit contribution from a SimParticle and PDG code.
              * @param simParticle The sim particle that made the contribution.
@@ -210,6 +259,11 @@ namespace ldmx {
              */
             TRefArray* simParticleContribs_;
 
+            /**
+             * The list of track IDs of the SimParticle objects contributing to the hit.
+             */
+            std::vector<int> trackIDContribs_;
+
             /**
              * The list of PDG codes contributing to the hit.
              */
@@ -233,7 +287,7 @@ namespace ldmx {
             /**
              * ROOT class definition.
              */
-            ClassDef(SimCalorimeterHit, 2)
+            ClassDef(SimCalorimeterHit, 3)
     };
 
 }
@@ -88,6 +88,14 @@ namespace ldmx {
                 return pdgID_;
             }
 
+            /**
+             * Get the Geant4 track ID of the particle.
+             * @return The track ID of the particle.
+             */
+            int getTrackID() const {
+                return trackID_;
+            }
+
             /**
              * Get the generator status of the particle.
              * A non-zero status indicates that the particle originates from
@@ -131,6 +139,30 @@ namespace ldmx {
                 return {px_, py_, pz_};
             }
 
+            /**
+             * Get the X momentum of the particle [MeV].
+             * @return The X momentum of the particle.
+             */
+            double getPx() const {
+                return px_;
+            }
+
+            /**
+             * Get the Y momentum of the particle [MeV].
+             * @return The Y momentum of the particle.
+             */
+            double getPy() const {
+                return py_;
+            }
+
+            /**
+             * Get the Z momentum of the particle [MeV].
+             * @return The Z momentum of the particle.
+             */
+            double getPz() const {
+                return pz_;
+            }
+
             /**
              * Get the mass of the particle [GeV].
              * @return The mass of the particle.
@@ -194,6 +226,14 @@ namespace ldmx {
                 this->pdgID_ = pdgID;
             }
 
+            /**
+             * Set the Geant4 track ID of the particle.
+             * @param trackID The track ID of the particle.
+             */
+            void setTrackID(const int trackID) {
+                this->trackID_ = trackID;
+            }
+
             /**
              * Set the generator status of the hit.
              * @param genStatus The generator status of the hit.
@@ -338,6 +378,9 @@ namespace ldmx {
             /** The generator status. */
             int genStatus_{-1};
 
+            /** The Geant4 track ID. */
+            int trackID_{-1};
+
             /** The global creation time. */
             double time_{0};
 
@@ -397,7 +440,7 @@ namespace ldmx {
             /**
              * ROOT class definition.
              */
-            ClassDef(SimParticle, 4);
+            ClassDef(SimParticle, 5);
     };
 
 }
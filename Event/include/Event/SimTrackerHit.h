@@ -73,6 +73,24 @@ namespace ldmx {
              */
             std::vector<float> getPosition() const { return {x_, y_, z_}; };
 
+            /**
+             * Get the X position of the hit [mm].
+             * @return The X position of the hit.
+             */
+            float getX() const { return x_; };
+
+            /**
+             * Get the Y position of the hit [mm].
+             * @return The Y position of the hit.
+             */
+            float getY() const { return y_; };
+
+            /**
+             * Get the Z position of the hit [mm].
+             * @return The Z position of the hit.
+             */
+            float getZ() const { return z_; };
+
             /**
              * Get the energy deposited on the hit [MeV].
              * @return The energy deposited on the hit.
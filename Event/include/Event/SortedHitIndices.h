@@ -0,0 +1,134 @@
+/**
+ * @file SortedHitIndices.h
+ * @brief Class that stores the sorted order of the hits of a collection
+ */
+
+#ifndef EVENT_SORTEDHITINDICES_H_
+#define EVENT_SORTEDHITINDICES_H_
+
+// ROOT
+#include "TObject.h"
+#include "TString.h"
+
+// STL
+#include <iostream>
+#include <vector>
+
+namespace ldmx {
+
+    /**
+     * @class SortedHitIndices
+     * @brief Stores the sorted order of the hits of a collection
+     *
+     * @note
+     * Rather than a sorted copy of the hits, this holds the permutation of
+     * the indices of the hits in their original collection.  The ith hit in 
+     * sorted order is at index getIndex(i) of the original collection.
+     */
+    class SortedHitIndices : public TObject {
+
+        public:
+
+            /**
+             * Class constructor.
+             */
+            SortedHitIndices();
+
+            /**
+             * Class destructor.
+             */
+            virtual ~SortedHitIndices();
+
+            /**
+             * Print a description of this object.
+             */
+            void Print(Option_t *option = "") const;
+
+            /**
+             * Reset the object.
+             */
+            void Clear(Option_t *option = "");
+
+            /**
+             * Copy this object.
+             * @param o The target object.
+             */
+            void Copy(TObject& o) const;
+
+            /**
+             * Return the name of the sorted collection.
+             * @return The name of the sorted collection.
+             */
+            const TString& getCollectionName() const {
+                return collectionName_;
+            }
+
+            /**
+             * Return the name of the hit variable the hits are sorted by.
+             * @return The name of the sort variable.
+             */
+            const TString& getSortedBy() const {
+                return sortedBy_;
+            }
+
+            /**
+             * Return the number of sorted hits.
+             * @return The number of hits.
+             */
+            int getNumHits() const {
+                return indices_.size();
+            }
+
+            /**
+             * Return the index in the original collection of the ith hit in 
+             * sorted order.
+             * @param i The position in sorted order.
+             * @return The index of the hit in the original collection.
+             */
+            int getIndex(int i) const {
+                return indices_[i];
+            }
+
+            /**
+             * Return the indices of the hits in sorted order.
+             * @return The indices of the hits.
+             */
+            const std::vector<int>& getIndices() const {
+                return indices_;
+            }
+
+            /**
+             * Set the names of the sorted collection and of the sort variable.
+             * @param collectionName The name of the sorted collection.
+             * @param sortedBy The name of the sort variable.
+             */
+            void set(const TString& collectionName, const TString& sortedBy) {
+                collectionName_ = collectionName;
+                sortedBy_ = sortedBy;
+            }
+
+            /**
+             * Set the indices of the hits in sorted order.  The contents of 
+             * the given vector are swapped in to avoid a copy.
+             * @param indices The indices of the hits.
+             */
+            void setIndices(std::vector<int>& indices) {
+                indices_.swap(indices);
+            }
+
+        private:
+
+            /** Name of the sorted collection. */
+            TString collectionName_;
+
+            /** Name of the hit variable the hits are sorted by. */
+            TString sortedBy_;
+
+            /** Indices in the original collection of the hits in sorted order. */
+            std::vector<int> indices_;
+
+            ClassDef(SortedHitIndices, 1);
+    };
+}
+
+#endif
@@ -0,0 +1,132 @@
+/**
+ * @file TruthSummary.h
+ * @brief Class that summarizes the Monte Carlo truth of an event
+ */
+
+#ifndef EVENT_TRUTHSUMMARY_H_
+#define EVENT_TRUTHSUMMARY_H_
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <iostream>
+#include <vector>
+
+//----------//
+//   ROOT   //
+//----------//
+#include <TObject.h>
+
+namespace ldmx {
+
+    /**
+     * @class TruthSummary
+     * @brief Summarizes the Monte Carlo truth of an event
+     *
+     * @note
+     * Particles are identified by their index in the SimParticles collection
+     * and ECal sim hits by their index in the EcalSimHits collection.  An 
+     * index of -1 means the particle was not found in the event.  The ECal 
+     * hits of the particles are stored as one list per particle, each list 
+     * being a contiguous range of a single array.
+     */
+    class TruthSummary : public TObject {
+
+        public:
+
+            /** Constructor */
+            TruthSummary();
+
+            /** Destructor */
+            ~TruthSummary();
+
+            /** Reset the object. */
+            void Clear(Option_t *option = "");
+
+            /** Copy this object. */
+            void Copy(TObject& object) const;
+
+            /** Print out the object. */
+            void Print(Option_t *option = "") const;
+
+            /** Get the index of the recoil electron. */
+            int getRecoilElectronIndex() const { return recoilElectronIndex_; }
+
+            /** Get the index of the photon which underwent a photonuclear reaction. */
+            int getPnGammaIndex() const { return pnGammaIndex_; }
+
+            /** Get the index of the photonuclear nucleon with the greatest kinetic energy. */
+            int getHardestNucleonIndex() const { return hardestNucleonIndex_; }
+
+            /** Get the number of particles with an ECal hit list. */
+            int getNumParticles() const { 
+                return ecalHitOffsets_.empty() ? 0 : ecalHitOffsets_.size() - 1; 
+            }
+
+            /** 
+             * Get the number of ECal sim hits with a contribution from a 
+             * particle. 
+             *
+             * @param particleIndex The index of the particle.
+             */
+            int getNumEcalHits(int particleIndex) const { 
+                return ecalHitOffsets_[particleIndex + 1] - ecalHitOffsets_[particleIndex];
+            }
+
+            /** 
+             * Get the index of the ith ECal sim hit with a contribution from
+             * a particle. 
+             *
+             * @param particleIndex The index of the particle.
+             * @param i The position of the hit in the hit list of the particle.
+             */
+            int getEcalHitIndex(int particleIndex, int i) const { 
+                return ecalHitIndices_[ecalHitOffsets_[particleIndex] + i];
+            }
+
+            /** Set the index of the recoil electron. */
+            void setRecoilElectronIndex(int index) { recoilElectronIndex_ = index; }
+
+            /** Set the index of the photon which underwent a photonuclear reaction. */
+            void setPnGammaIndex(int index) { pnGammaIndex_ = index; }
+
+            /** Set the index of the photonuclear nucleon with the greatest kinetic energy. */
+            void setHardestNucleonIndex(int index) { hardestNucleonIndex_ = index; }
+
+            /**
+             * Set the ECal hit lists of the particles.  The hits of the nth
+             * particle are at positions [offsets[n], offsets[n + 1]) of the 
+             * hit indices.  The contents of the given vectors are swapped in 
+             * to avoid a copy.
+             *
+             * @param offsets The start of the hit list of each particle,
+             *                followed by the total number of hits.
+             * @param hitIndices The concatenated hit lists. 
+             */
+            void setEcalHits(std::vector<int>& offsets, std::vector<int>& hitIndices) { 
+                ecalHitOffsets_.swap(offsets);
+                ecalHitIndices_.swap(hitIndices);
+            }
+
+        private:
+
+            /** Index of the recoil electron. */
+            int recoilElectronIndex_{-1};
+
+            /** Index of the photon which underwent a photonuclear reaction. */
+            int pnGammaIndex_{-1};
+
+            /** Index of the photonuclear nucleon with the greatest kinetic energy. */
+            int hardestNucleonIndex_{-1};
+
+            /** Start of the ECal hit list of each particle in ecalHitIndices_. */
+            std::vector<int> ecalHitOffsets_;
+
+            /** ECal hit lists of all particles. */
+            std::vector<int> ecalHitIndices_;
+
+        ClassDef(TruthSummary, 1);
+    };
+}
+
+#endif // EVENT_TRUTHSUMMARY_H_
@@ -0,0 +1,55 @@
+/**
+ * @file EcalCluster.cxx
+ * @brief Class that stores a cluster of neighboring ECal hits
+ */
+
+#include "Event/EcalCluster.h"
+
+ClassImp(ldmx::EcalCluster)
+
+namespace ldmx {
+
+    EcalCluster::EcalCluster() :
+        TObject() {
+    }
+
+    EcalCluster::~EcalCluster() {
+        Clear();
+    }
+
+    void EcalCluster::Clear(Option_t *option) {
+        TObject::Clear();
+
+        energy_ = 0;
+        centroidX_ = 0;
+        centroidY_ = 0;
+        meanLayer_ = 0;
+        firstLayer_ = -1;
+        lastLayer_ = -1;
+        seedIndex_ = -1;
+        hitIndices_.clear();
+    }
+
+    void EcalCluster::Copy(TObject& object) const { 
+        EcalCluster& cluster = (EcalCluster&) object; 
+
+        cluster.energy_ = energy_;
+        cluster.centroidX_ = centroidX_;
+        cluster.centroidY_ = centroidY_;
+        cluster.meanLayer_ = meanLayer_;
+        cluster.firstLayer_ = firstLayer_;
+        cluster.lastLayer_ = lastLayer_;
+        cluster.seedIndex_ = seedIndex_;
+        cluster.hitIndices_ = hitIndices_;
+    }
+
+    void EcalCluster::Print(Option_t *option) const { 
+        std::cout << "[ EcalCluster ]: "
+                  << "Energy: " << energy_ << " MeV\n"
+                  << "\tHits: " << hitIndices_.size() << "\n"
+                  << "\tSeed hit index: " << seedIndex_ << "\n"
+                  << "\tCentroid: (" << centroidX_ << ", " << centroidY_ << ") mm\n"
+                  << "\tLayers: [" << firstLayer_ << ", " << lastLayer_ << "], mean " << meanLayer_ << "\n"
+                  << std::endl;
+    }
+}
@@ -19,6 +19,7 @@ namespace ldmx {
     const std::string EventConstants::TARGET_SIM_HITS = "TargetSimHits";
     const std::string EventConstants::TRIGGER_PAD_SIM_HITS = "TriggerPadSimHits";
     const std::string EventConstants::TRIGGER_RESULT = "TriggerResult";
+    const std::string EventConstants::TRUTH_SUMMARY = "TruthSummary";
 
     /*
      * Type names.
@@ -31,4 +32,10 @@ namespace ldmx {
     const std::string EventConstants::RUN_HEADER = "ldmx::RunHeader";
     const std::string EventConstants::PN_WEIGHT = "ldmx::pnWeight";
 
+    /*
+     * Run header parameter names.
+     */
+    const std::string EventConstants::ECAL_HEX_RADIUS = "ECAL_HEX_RADIUS";
+    const std::string EventConstants::ECAL_HEX_GAP = "ECAL_HEX_GAP";
+
 } // namespace event
@@ -51,6 +51,7 @@ namespace ldmx {
         is2aFindable_   = false; 
         is2sFindable_   = false;
         is3sFindable_   = false;
+        findableMask_   = 0;
     }
 
     void FindableTrackResult::Print(Option_t *option) { 
@@ -63,6 +64,7 @@ namespace ldmx {
                   << "\t2a Findable: "   << is2aFindable_  << "\n"
                   << "\t2s Findable: "   << is2sFindable_  << "\n"
                   << "\t3s Findable: "   << is3sFindable_  << "\n"
+                  << "\tFindable mask: " << findableMask_  << "\n"
                   << std::endl;
     }
 }
@@ -21,13 +21,27 @@ namespace ldmx {
     void HcalVetoResult::Copy(TObject& object) const { 
         HcalVetoResult& result = (HcalVetoResult&) object;
         result.passesVeto_	    	= passesVeto_;
+        result.backPE_              = backPE_;
+        result.sidePE_              = sidePE_;
+        result.maxPE_               = maxPE_;
+        result.outOfTimePE_         = outOfTimePE_;
+        result.maxPEHitID_          = maxPEHitID_;
     }
 
     void HcalVetoResult::Clear(Option_t *option) { 
         passesVeto_ = false; 
+        backPE_ = 0;
+        sidePE_ = 0;
+        maxPE_ = 0;
+        outOfTimePE_ = 0;
+        maxPEHitID_ = 0;
     }
 
     void HcalVetoResult::Print(Option_t *option) { 
-        std::cout << "[ HcalVetoResult ]: Passes veto : " << passesVeto_ << std::endl;
+        std::cout << "[ HcalVetoResult ]: Passes veto : " << passesVeto_ << "\n"
+                  << "\tBack PE: " << backPE_ << "\n"
+                  << "\tSide PE: " << sidePE_ << "\n"
+                  << "\tMax PE: " << maxPE_ << "\n"
+                  << "\tOut of time PE: " << outOfTimePE_ << std::endl;
     }
 }
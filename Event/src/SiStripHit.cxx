@@ -22,7 +22,11 @@ namespace ldmx {
             std::cout << adcValue << ", "; 
         }
         std::cout << " ]\n"  
-                  << "\t Time: " << time_ << std::endl;
+                  << "\t Time: " << time_ << "\n"
+                  << "\t Layer: " << layerID_ << " Module: " << moduleID_ << "\n"
+                  << "\t Strips: [ " << firstStrip_ << ", " << lastStrip_ << " ]\n"
+                  << "\t Charge: " << charge_ << "\n"
+                  << "\t Position: ( " << x_ << ", " << y_ << ", " << z_ << " )" << std::endl;
 
     }
 
@@ -30,6 +34,14 @@ namespace ldmx {
         TObject::Clear();  
         adcValues_.clear(); 
         time_ = -9999;
+        layerID_ = -1;
+        moduleID_ = -1;
+        firstStrip_ = 0;
+        lastStrip_ = -1;
+        charge_ = 0;
+        x_ = 0;
+        y_ = 0;
+        z_ = 0;
         simTrackerHits_->Delete();  
     }
 
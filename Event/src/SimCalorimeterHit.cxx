@@ -22,6 +22,7 @@ namespace ldmx {
         TObject::Clear();
 
         simParticleContribs_->Delete();
+        trackIDContribs_.clear();
         pdgCodeContribs_.clear();
         edepContribs_.clear();
         timeContribs_.clear();
@@ -40,8 +41,9 @@ namespace ldmx {
                 "position: ( " << x_ << ", " << y_ << ", " << z_ << " ) }" << std::endl;
     }
 
-    void SimCalorimeterHit::addContrib(SimParticle* simParticle, int pdgCode, float edep, float time) {
+    void SimCalorimeterHit::addContrib(SimParticle* simParticle, int pdgCode, float edep, float time, int trackID) {
         simParticleContribs_->Add(simParticle);
+        trackIDContribs_.push_back(trackID);
         pdgCodeContribs_.push_back(pdgCode);
         edepContribs_.push_back(edep);
         timeContribs_.push_back(time);
@@ -55,6 +57,7 @@ namespace ldmx {
     SimCalorimeterHit::Contrib SimCalorimeterHit::getContrib(int i) {
         Contrib contrib;
         contrib.particle = (SimParticle*) simParticleContribs_->At(i);
+        contrib.trackID = i >= 0 && static_cast<std::size_t>(i) < trackIDContribs_.size() ? trackIDContribs_[i] : -1;
         contrib.edep = edepContribs_[i];
         contrib.time = timeContribs_[i];
         contrib.pdgCode = pdgCodeContribs_[i];
@@ -43,6 +43,7 @@ namespace ldmx {
         energy_ = 0;
         pdgID_ = 0;
         genStatus_ = -1;
+        trackID_ = -1;
         time_ = 0;
         x_ = 0;
         y_ = 0;
@@ -66,6 +67,7 @@ namespace ldmx {
                 "energy: " << energy_ << ", " <<
                 "PDG ID: " << pdgID_ << ", " <<
                 "genStatus: " << genStatus_ << ", " <<
+                "trackID: " << trackID_ << ", " <<
                 "time: " << time_ << ", " <<
                 "vertex: ( " << x_ << ", " << y_ << ", " << z_ << " ), " <<
                 "endPoint: ( " << endX_ << ", " << endY_ << ", " << endZ_ << " ), " <<
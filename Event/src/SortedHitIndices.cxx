@@ -0,0 +1,36 @@
+#include "Event/SortedHitIndices.h"
+
+ClassImp(ldmx::SortedHitIndices)
+
+namespace ldmx {
+
+    SortedHitIndices::SortedHitIndices() : TObject() {
+    }
+
+    SortedHitIndices::~SortedHitIndices() {
+        Clear();
+    }
+
+    void SortedHitIndices::Print(Option_t *option) const {
+        std::cout << "SortedHitIndices { " << "collection: " << collectionName_ << ", " 
+                  << "sorted by: " << sortedBy_ << ", " << "hits: " << indices_.size() << " }" << std::endl;
+    }
+
+    void SortedHitIndices::Clear(Option_t*) {
+
+        TObject::Clear();
+
+        collectionName_ = "";
+        sortedBy_ = "";
+        indices_.clear();
+    }
+
+    void SortedHitIndices::Copy(TObject& ob) const {
+
+        SortedHitIndices& sorted = (SortedHitIndices&) (ob);
+        sorted.collectionName_ = collectionName_;
+        sorted.sortedBy_ = sortedBy_;
+        sorted.indices_ = indices_;
+    }
+
+}
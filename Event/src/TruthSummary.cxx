@@ -0,0 +1,48 @@
+/**
+ * @file TruthSummary.cxx
+ * @brief Class that summarizes the Monte Carlo truth of an event
+ */
+
+#include "Event/TruthSummary.h"
+
+ClassImp(ldmx::TruthSummary)
+
+namespace ldmx {
+
+    TruthSummary::TruthSummary() :
+        TObject() {
+    }
+
+    TruthSummary::~TruthSummary() {
+        Clear();
+    }
+
+    void TruthSummary::Clear(Option_t *option) {
+        TObject::Clear();
+
+        recoilElectronIndex_ = -1;
+        pnGammaIndex_ = -1;
+        hardestNucleonIndex_ = -1;
+        ecalHitOffsets_.clear();
+        ecalHitIndices_.clear();
+    }
+
+    void TruthSummary::Copy(TObject& object) const { 
+        TruthSummary& summary = (TruthSummary&) object; 
+
+        summary.recoilElectronIndex_ = recoilElectronIndex_;
+        summary.pnGammaIndex_ = pnGammaIndex_;
+        summary.hardestNucleonIndex_ = hardestNucleonIndex_;
+        summary.ecalHitOffsets_ = ecalHitOffsets_;
+        summary.ecalHitIndices_ = ecalHitIndices_;
+    }
+
+    void TruthSummary::Print(Option_t *option) const { 
+        std::cout << "[ TruthSummary ]: "
+                  << "Recoil electron index: " << recoilElectronIndex_ << "\n"
+                  << "\tPN gamma index: " << pnGammaIndex_ << "\n"
+                  << "\tHardest nucleon index: " << hardestNucleonIndex_ << "\n"
+                  << "\tECal hit contributions: " << ecalHitIndices_.size() << "\n"
+                  << std::endl;
+    }
+}
@@ -0,0 +1,206 @@
+/**
+ * @file EcalClusterProducer.h
+ * @brief Processor that clusters neighboring ECal hits in three dimensions.
+ */
+
+#ifndef EVENTPROC_ECALCLUSTERPRODUCER_H_
+#define EVENTPROC_ECALCLUSTERPRODUCER_H_
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <string>
+#include <vector>
+
+//----------//
+//   ROOT   //
+//----------//
+#include "TClonesArray.h"
+
+//----------//
+//   LDMX   //
+//----------//
+#include "Event/EcalCluster.h"
+#include "Event/EcalHit.h"
+#include "Event/EventConstants.h"
+#include "DetDescr/EcalDetectorID.h"
+#include "DetDescr/EcalHexReadout.h"
+#include "Framework/EventProcessor.h"
+
+namespace ldmx {
+
+    /**
+     * @class EcalClusterProducer
+     * @brief Clusters neighboring ECal hits in three dimensions
+     *
+     * @note
+     * Two hits are neighbors if their cells are nearest neighbors (and 
+     * optionally next-to-nearest neighbors) in the same layer, or if they 
+     * are in the same or nearest neighbor cells of layers at most 
+     * max_layer_gap apart.  Clusters are the connected sets of neighbors,
+     * found with a union-find over the hits.  Hits are looked up by a dense 
+     * channel index, and the neighbors of each cell are precomputed as a 
+     * flat table, so no maps are searched per hit.
+     */
+    class EcalClusterProducer : public Producer {
+
+        public:
+
+            /** Constructor */
+            EcalClusterProducer(const std::string &name, Process &process);
+
+            /** Destructor */
+            ~EcalClusterProducer();
+
+            /**
+             * Configure the processor using the given user specified parameters.
+             *
+             * @param pSet Set of parameters used to configure this processor.
+             */
+            void configure(const ParameterSet &pSet);
+
+            /**
+             * Switch to the hex readout of the new run, with the ECal geometry
+             * stored in its header or, for older runs, known for its detector.
+             * @param runHeader The header of the new run.
+             * @throw Exception if the ECal geometry of the run is unknown.
+             */
+            void onNewRun(const RunHeader& runHeader);
+
+            /**
+             * Run the processor and create a collection of ECal clusters.
+             *
+             * @param event The event to process.
+             */
+            void produce(Event &event);
+
+        private:
+
+            /** Number of ECal layers with a channel index. */
+            static const int NUM_ECAL_LAYERS{34};
+
+            /** Total number of hex modules per layer. */
+            static const int HEX_MODULES_PER_LAYER{7};
+
+            /** Total number of cells (channels) per hex module. */
+            static const int CELLS_PER_HEX_MODULE{397};
+
+            /** Total number of cells in a layer. */
+            static const int CELLS_PER_LAYER{HEX_MODULES_PER_LAYER*CELLS_PER_HEX_MODULE};
+
+            /**
+             * Get the index of a cell within its layer from a raw ECal ID,
+             * i.e. module*CELLS_PER_HEX_MODULE + cell.
+             *
+             * @param detIDraw The raw detector ID.
+             * @return The cell index, which is not range checked.
+             */
+            static int getLayerCellIndex(int detIDraw) {
+                int module = EcalDetectorID::ModuleField::decode(detIDraw);
+                int cell = EcalDetectorID::CellField::decode(detIDraw);
+                return module*CELLS_PER_HEX_MODULE + cell;
+            }
+
+            /**
+             * Build the neighbor table and the cell positions from the hex
+             * readout.
+             */
+            void buildNeighborTable();
+
+            /**
+             * Find the root of the set containing a hit, halving the path on
+             * the way.
+             *
+             * @param hit The slot of the hit.
+             * @return The slot of the root hit.
+             */
+            int findRoot(int hit) {
+                while (parents_[hit] != hit) {
+                    parents_[hit] = parents_[parents_[hit]];
+                    hit = parents_[hit];
+                }
+                return hit;
+            }
+
+            /**
+             * Merge the sets containing two hits, attaching the smaller set
+             * to the larger one.
+             *
+             * @param hitA The slot of the first hit.
+             * @param hitB The slot of the second hit.
+             */
+            void merge(int hitA, int hitB);
+
+            /** Name of the collection of ECal digis. */
+            std::string digiCollection_{"ecalDigis"};
+
+            /** Name of the collection of clusters. */
+            std::string clusterCollection_{"ecalClusters"};
+
+            /** Smallest energy of a hit used in the clustering [MeV]. */
+            double minHitEnergy_{0};
+
+            /** Smallest energy of a cluster which is kept [MeV]. */
+            double minClusterEnergy_{0};
+
+            /** Smallest number of hits of a cluster which is kept. */
+            int minClusterHits_{1};
+
+            /** Largest number of layers between two neighboring hits. */
+            int maxLayerGap_{1};
+
+            /** Whether next-to-nearest neighbors in a layer are neighbors. */
+            bool useNNN_{false};
+
+            /** Shared hex readout used to find the neighbors of each cell. */
+            const EcalHexReadout* hexReadout_{nullptr};
+
+            /** Cache file of the hex readouts, only used when a readout is first built. */
+            std::string hexReadoutCache_;
+
+            /** Start of the neighbors of each cell in neighborCells_. */
+            std::vector<int> neighborOffsets_;
+
+            /** Cells neighboring each cell in the same layer. */
+            std::vector<int> neighborCells_;
+
+            /** Position of the end of the nearest neighbors of each cell in neighborCells_. */
+            std::vector<int> nnEnds_;
+
+            /** X position of each cell relative to the ECal center [mm]. */
+            std::vector<float> cellX_;
+
+            /** Y position of each cell relative to the ECal center [mm]. */
+            std::vector<float> cellY_;
+
+            /** Slot of the hit in each channel, or -1 if it has no hit. */
+            std::vector<int> channelHits_;
+
+            /** Channel index of each hit slot. */
+            std::vector<int> hitChannels_;
+
+            /** Index of the hit in the digi collection of each hit slot. */
+            std::vector<int> hitIndices_;
+
+            /** Energy of each hit slot [MeV]. */
+            std::vector<float> hitEnergies_;
+
+            /** Parent of each hit slot in the union-find forest. */
+            std::vector<int> parents_;
+
+            /** Size of the set of each root hit slot. */
+            std::vector<int> setSizes_;
+
+            /** Energy of the set of each root hit slot [MeV]. */
+            std::vector<float> setEnergies_;
+
+            /** Cluster of each root hit slot, or -1 if it has none. */
+            std::vector<int> rootClusters_;
+
+            /** Collection of clusters. */
+            TClonesArray* clusters_{nullptr};
+
+    }; // EcalClusterProducer
+}
+
+#endif // EVENTPROC_ECALCLUSTERPRODUCER_H_
@@ -11,7 +11,9 @@
 //----------------//
 //   C++ StdLib   //
 //----------------//
+#include <bitset>
 #include <time.h>
+#include <vector>
 
 //----------//
 //   ROOT   //
@@ -25,6 +27,7 @@
 #include "Event/EcalHit.h"
 #include "Event/EventConstants.h"
 #include "Event/SimCalorimeterHit.h"
+#include "DetDescr/ChannelConditions.h"
 #include "DetDescr/DetectorID.h"
 #include "DetDescr/EcalDetectorID.h"
 #include "DetDescr/EcalHexReadout.h"
@@ -45,6 +48,12 @@ namespace ldmx {
 
             typedef std::pair<int, float> cell_energy_pair;
 
+            /** Electrons per MIP. */
+            static constexpr double ELECTRONS_PER_MIP{33000.0}; // e-
+
+            /** MIP response in MeV. */
+            static constexpr double MIP_SI_RESPONSE{0.130}; // MeV
+
             EcalDigiProducer(const std::string& name, Process& process);
 
             virtual ~EcalDigiProducer() {
@@ -52,6 +61,14 @@ namespace ldmx {
 
             virtual void configure(const ParameterSet&);
 
+            /**
+             * Switch to the hex readout of the new run, with the ECal geometry
+             * stored in its header or, for older runs, known for its detector.
+             * @param runHeader The header of the new run.
+             * @throw Exception if the ECal geometry of the run is unknown.
+             */
+            virtual void onNewRun(const RunHeader& runHeader);
+
             virtual void produce(Event& event);
 
         private:
@@ -66,22 +83,46 @@ namespace ldmx {
                 return noiseIntercept + noiseSlope*capacitance;
             } 
             
-            inline layer_cell_pair hitToPair(SimCalorimeterHit* hit) {
-                int detIDraw = hit->getID();
-                detID_.setRawValue(detIDraw);
-                detID_.unpack();
-                int layer = detID_.getFieldValue("layer");
-                int cellid = detID_.getFieldValue("cell");
-                return (std::make_pair(layer, cellid));
+            /**
+             * Decode the layer from a raw ECal ID with the static codec
+             * rather than the DetectorID field map.
+             *
+             * @param detIDraw The raw detector ID.
+             * @return The layer number.
+             */
+            static int getLayer(int detIDraw) {
+                return EcalDetectorID::LayerField::decode(detIDraw);
             }
 
-        private:
+            /**
+             * Get the dense channel index (position in the channel list) of 
+             * a decoded ECal ID, i.e. (layer*HEX_MODULES_PER_LAYER + module)*CELLS_PER_HEX_MODULE + cell.
+             *
+             * @param layer The layer.
+             * @param module The module position.
+             * @param cell The cell.
+             * @return The channel index, which is not range checked.
+             */
+            static int getChannelIndex(int layer, int module, int cell) {
+                return (layer*HEX_MODULES_PER_LAYER + module)*CELLS_PER_HEX_MODULE + cell;
+            }
 
-            /** Electrons per MIP. */
-            static const double ELECTRONS_PER_MIP; 
+            /**
+             * Build the flat list of packed IDs for every valid ECal channel
+             * (layer, module, cell), ordered by channel index.  Noise hits are
+             * placed by drawing an index into this list.  The subdetector 
+             * field is left 0, and set for each noise hit to that of the sim 
+             * hits, which depends on the detector.
+             */
+            void buildChannelList();
 
-            /** MIP response in MeV. */
-            static const double MIP_SI_RESPONSE;
+            /**
+             * Group the unmasked channels by their noise RMS and pedestal, so
+             * the noise hits of each group can be drawn with its own noise.
+             */
+            void buildNoiseGroups();
+
+        private:
 
             /** Total number of Ecal layers. */
             static const int NUM_ECAL_LAYERS{33};
@@ -92,17 +133,73 @@ namespace ldmx {
             /** Total number of cells (channels) per hex module. */
             static const int CELLS_PER_HEX_MODULE{397};
 
+            /** 
+             * Subdetector ID of the ECal in the current detectors, used for 
+             * the noise hits of events without sim hits to take it from.
+             */
+            static const unsigned DEFAULT_ECAL_SUBDET{5};
+
             /** Total number of cells across all modules. */
             static const int TOTAL_CELLS{NUM_ECAL_LAYERS*HEX_MODULES_PER_LAYER*CELLS_PER_HEX_MODULE};
 
 
+            /**
+             * Base seed for the random number generators.  Both generators
+             * are reseeded at the start of every event from a hash of this 
+             * seed, the run and the event number, so the digis of an event 
+             * are reproducible.
+             */
+            unsigned int randomSeed_{0};
+
             TRandom3* noiseInjector_{new TRandom3(time(nullptr))};
             TClonesArray* ecalDigis_{nullptr};
-            EcalDetectorID detID_;
-            EcalHexReadout* hexReadout_{nullptr};
+            const EcalHexReadout* hexReadout_{nullptr};
+
+            /** Cache file of the hex readouts, only used when a readout is first built. */
+            std::string hexReadoutCache_;
           
             /** Generator of noise hits. */ 
             NoiseGenerator* noiseGenerator_{new NoiseGenerator{}}; 
+
+            /** Gaussian noise for each sim hit, refilled every event. */
+            std::vector<double> hitNoise_;
+
+            /** Packed IDs of all valid ECal channels, ordered by channel index. */
+            std::vector<int> channelIDs_;
+
+            /** Channels with a sim hit or a noise hit in the current event. */
+            std::bitset<TOTAL_CELLS> occupiedChannels_;
+
+            /** Per-channel conditions, indexed by channel index. */
+            const ChannelConditions* conditions_{nullptr};
+
+            /** 
+             * Channels sharing a noise RMS and pedestal, for which the number
+             * of noise hits above threshold is drawn together.
+             */
+            struct NoiseGroup { 
+
+                /** Noise RMS of the channels [MeV]. */
+                double noise{0};
+
+                /** Pedestal of the channels [MeV]. */
+                double pedestal{0};
+
+                /** Indices of the channels in the group. */
+                std::vector<int> channels;
+            };
+
+            /** Groups of unmasked channels with the same noise and pedestal. */
+            std::vector<NoiseGroup> noiseGroups_;
+
+            /** Noise group of each channel, or -1 for masked channels. */
+            std::vector<int> channelNoiseGroups_;
+
+            /** 
+             * Dead and hot channels, which are kept out of the noise hits by 
+             * starting every event with them marked as occupied. 
+             */
+            std::bitset<TOTAL_CELLS> maskedChannels_;
            
             /** Set the noise (in electrons) when the capacitance is 0. */
             double noiseIntercept_{900.};
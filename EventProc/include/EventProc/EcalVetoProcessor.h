@@ -74,6 +74,14 @@ namespace ldmx {
 
             void configure(const ParameterSet&);
 
+            /**
+             * Switch to the hex readout of the new run, with the ECal geometry
+             * stored in its header or, for older runs, known for its detector.
+             * @param runHeader The header of the new run.
+             * @throw Exception if the ECal geometry of the run is unknown.
+             */
+            void onNewRun(const RunHeader& runHeader);
+
             void produce(Event& event);
 
         private:
@@ -91,16 +99,20 @@ namespace ldmx {
             XYCoords getCellCentroidXYPair(int centroidID){
                 return hexReadout_->getCellCenterAbsolute(centroidID);
             }
-            std::vector<int> getInnerRingCellIds(int cellModuleID){
+            IDRange getInnerRingCellIds(int cellModuleID){
                 return hexReadout_->getNN(cellModuleID);
             }
-            std::vector<int> getOuterRingCellIds(int cellModuleID){
+            IDRange getOuterRingCellIds(int cellModuleID){
                 return hexReadout_->getNNN(cellModuleID);
             }
 
             void clearProcessor();
 
-            LayerCellPair hitToPair(EcalHit* hit);
+            /**
+             * Get the layer and combined cell and module ID of a digi.
+             * @param hit The digi.
+             */
+            static LayerCellPair hitToPair(const EcalHit* hit);
 
             /* Function to calculate the energy weighted shower centroid */
             int GetShowerCentroidIDAndRMS(const TClonesArray* ecalDigis, double & showerRMS);
@@ -143,11 +155,13 @@ namespace ldmx {
             double bdtCutVal_{0};
 
             EcalVetoResult result_;
-            EcalDetectorID detID_;
             bool verbose_{false};
             bool doesPassVeto_{false};
 
-            EcalHexReadout* hexReadout_{nullptr};
+            const EcalHexReadout* hexReadout_{nullptr};
+
+            /** Cache file of the hex readouts, only used when a readout is first built. */
+            std::string hexReadoutCache_;
 
             std::string bdtFileName_;
             BDTHelper* BDTHelper_{nullptr};
@@ -22,6 +22,13 @@
 //----------//
 #include <TClonesArray.h>
 
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace ldmx { 
 
     class FindableTrackProcessor : public Producer { 
@@ -51,26 +58,71 @@ namespace ldmx {
             
         private:
 
+            /** Number of layers in the recoil tracker. */
+            static const int N_RECOIL_LAYERS{10};
+
+            /** Maximum number of strategies, the size of the findable bit mask. */
+            static const int MAX_STRATEGIES{32};
+
+            /**
+             * Map each sim particle to a dense index, its position in the
+             * collection of sim particles.
+             *
+             * @param simParticles The collection of sim particles.
+             */
+            void indexParticles(const TClonesArray* simParticles);
+
+            /**
+             * Get the dense index of a sim particle.
+             *
+             * @param simParticle The sim particle.
+             * @return The index of the particle or -1 if it isn't in the 
+             *         collection of sim particles.
+             */
+            int getParticleIndex(const SimParticle* simParticle) const;
+
             /**
              * Create a hit map which associates a charged particle to it's 
              * hits in the recoil tracker.
              *
-             * @param recoilSimHit collection of simulated recoil tracker hits.
+             * @param siStripHits collection of recoil tracker strip hits.
              */
             void createHitMap(const TClonesArray* siStripHits);
           
             /** 
-             * Given a set of hits, check if a sim particle is expected to fall
-             * within the acceptance of the recoil tracker.
+             * Given a set of hits, check which strategies can find a sim 
+             * particle.  A strategy can find a particle if the particle hit 
+             * all the layers of any of the strategy's required layer masks.
              *
              * @param result The object used to encapsulate the results.
-             * @param hitCount Vector indicating whether the nth layer of the 
-             *                 recoil tracker has a hit.
+             * @param layerMask Bit mask whose nth bit is set if the nth layer
+             *                  of the recoil tracker has a hit.
+             */
+            void isFindable(FindableTrackResult* result, unsigned layerMask); 
+
+            /** Names of the strategies, in the order of the findable bit mask. */
+            std::vector<std::string> strategyNames_;
+
+            /** 
+             * Legacy result flag set by each strategy, STRATEGY_NONE if the 
+             * strategy only appears in the findable bit mask. 
+             */
+            std::vector<FindableTrackResult::Strategy> legacyStrategies_;
+
+            /** Required layer masks of all strategies. */
+            std::vector<unsigned> requiredLayers_;
+
+            /** Bit of the strategy each required layer mask belongs to. */
+            std::vector<unsigned> strategyBits_;
+
+            /** 
+             * Sim particles sorted by address along with their index in the 
+             * collection of sim particles. 
              */
-            void isFindable(FindableTrackResult* result, std::vector<int> hitCount); 
+            std::vector<std::pair<const SimParticle*, int>> particleIndices_;
 
-            /** Map between a sim particle and it's hit array. */ 
-            std::map<SimParticle*, std::vector<int>> hitMap_;
+            /** Bit mask of the layers hit by each particle. */
+            std::vector<unsigned> layerMasks_;
 
             /** Collection of results. */
             TClonesArray* findableTrackResults_{nullptr};
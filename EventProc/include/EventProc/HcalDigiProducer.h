@@ -7,12 +7,18 @@
 #ifndef EVENTPROC_HCALDIGIPRODUCER_H_
 #define EVENTPROC_HCALDIGIPRODUCER_H_
 
+// STL
+#include <cfloat>
+#include <vector>
+
 // ROOT
 #include "TString.h"
 #include "TRandom.h"
 
 // LDMX
+#include "DetDescr/ChannelConditions.h"
 #include "DetDescr/DetectorID.h"
+#include "DetDescr/HcalID.h"
 #include "Event/SimCalorimeterHit.h"
 #include "Framework/EventProcessor.h"
 
@@ -42,17 +48,172 @@ namespace ldmx {
 
             virtual void produce(Event& event);
 
+        private:
+
+            /**
+             * @struct ChannelSums
+             * @brief Sums over the sim hits of a single channel (detID)
+             *
+             * @note
+             * The time and position sums are weighted by the energy 
+             * deposition so they become averages after dividing by edep.
+             */
+            struct ChannelSums {
+                int detID{0};
+                float edep{0};
+                float time{0};
+                float x{0};
+                float y{0};
+                float z{0};
+                /** Mean number of PEs expected at each end of the strip. */
+                float meanPE[2] = {0, 0};
+                /** Arrival time of the first light at each end of the strip. */
+                float arrival[2] = {FLT_MAX, FLT_MAX};
+            };
+
+            /** Geometry of the strips: back strips run along x, side strips along z. */
+            enum StripType {
+                BACK_STRIP = 0,
+                SIDE_STRIP = 1,
+                N_STRIP_TYPES = 2
+            };
+
+            /**
+             * Fill the lookup tables of the PE yield and the light 
+             * propagation time to both ends of a strip as a function of 
+             * the position bin along the strip.  All strips of a section
+             * have the same length, so the tables are indexed by the strip 
+             * type rather than by the individual strip.
+             */
+            void buildReadoutTables();
+
+            /**
+             * Get the strip type of a section.
+             * @param section The section.
+             * @return The strip type.
+             */
+            static int getSectionStripType(int section) {
+                return section == BACK ? BACK_STRIP : SIDE_STRIP;
+            }
+
+            /**
+             * Get the strip type from the section field of a raw ID.
+             * @param detIDraw The raw ID.
+             * @return The strip type.
+             */
+            static int getStripType(int detIDraw) {
+                return getSectionStripType(HcalID::SectionField::decode(detIDraw));
+            }
+
+            /**
+             * Get the dense channel index of a raw ID in the conditions, 
+             * layer + 256*(section + 8*strip).  The layer, section and strip 
+             * fields are next to each other in the ID, so this is bits 4-22.
+             * @param detIDraw The raw ID.
+             * @return The channel index.
+             */
+            static unsigned getChannelIndex(int detIDraw) {
+                return IDBitField<HcalID::LayerField::START_BIT, HcalID::StripField::END_BIT>::decode(detIDraw);
+            }
+
+            /**
+             * Get the index of a position along a strip in the readout 
+             * tables.  Positions beyond the ends are put in the end bins.
+             * @param stripType The strip type.
+             * @param pos The position along the strip, relative to its center.
+             * @return The index of the first end in the readout tables.
+             */
+            int getTableIndex(int stripType, float pos) const;
+
+            /**
+             * Find the sums of a channel, adding an empty entry the first 
+             * time a channel is seen in the event.  This is a lookup in an
+             * open-addressing hash table with linear probing.
+             *
+             * @param detIDraw The raw ID of the channel.
+             * @return The sums of the channel.
+             */
+            ChannelSums& getChannelSums(int detIDraw);
+
+            /** 
+             * Empty the channel table by resetting only the slots which were 
+             * used in the current event. 
+             */
+            void clearChannels();
+
+            /**
+             * Double the size of the hash table and reinsert the channels 
+             * of the current event.
+             */
+            void growChannelTable();
+
+            /**
+             * Hash a raw ID into a slot of the hash table.
+             * @param detIDraw The raw ID.
+             * @return The slot index.
+             */
+            unsigned hashChannel(int detIDraw) const {
+                return (unsigned(detIDraw)*2654435761u) >> (32 - tableBits_);
+            }
 
         private:
 
+            /** Sums of the channels hit in the current event, in insertion order. */
+            std::vector<ChannelSums> channels_;
+
+            /** 
+             * Hash table mapping a slot to an index in channels_, or -1 if 
+             * the slot is empty. 
+             */
+            std::vector<int> channelTable_;
+
+            /** Slot used by each entry of channels_, for fast clearing. */
+            std::vector<unsigned> usedSlots_;
+
+            /** Number of bits in the hash table size. */
+            unsigned tableBits_{12};
+
+            /** 
+             * PE per MeV reaching each end of a strip, indexed by 
+             * [strip type][position bin][end]. 
+             */
+            std::vector<float> peYield_;
+
+            /** 
+             * Light propagation time [ns] to each end of a strip, indexed by 
+             * [strip type][position bin][end]. 
+             */
+            std::vector<float> propagationTime_;
+
+            /** Length of the strips [mm], per strip type. */
+            double stripLength_[N_STRIP_TYPES] = {3100., 290.};
+
+            /** Position of the strip centers along the strips [mm], per strip type. */
+            double stripCenter_[N_STRIP_TYPES] = {0., 345.};
+
+            /** Number of position bins along a strip in the readout tables. */
+            int nPositionBins_{64};
+
+            /** Attenuation length of the light in the strip [mm]. */
+            double attenuationLength_{5000.};
+
+            /** Velocity of the light in the strip [mm/ns]. */
+            double lightVelocity_{187.};
+
+            /** Resolution of the arrival time at each end [ns]. */
+            double timeResolution_{0.5};
+
             TClonesArray* hits_{nullptr};
             TRandom* random_{0};
             std::map<layer, zboundaries> hcalLayers_;
             bool verbose_{false};
-            DetectorID* detID_{nullptr};
 
             double meanNoise_{0};
             int    nProcessed_{0};
+
+            /** Per-channel conditions, indexed by getChannelIndex(). */
+            const ChannelConditions* conditions_{nullptr};
+
             double mev_per_mip_{1.40};
             double pe_per_mip_{13.5};
             int    doStrip_{true};
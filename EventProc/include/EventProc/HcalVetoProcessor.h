@@ -7,6 +7,11 @@
 #ifndef EVENTPROC_HCALVETOPROCESSOR_H_
 #define EVENTPROC_HCALVETOPROCESSOR_H_
 
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <limits>
+
 //----------//
 //   LDMX   //
 //----------//
@@ -54,6 +59,21 @@ namespace ldmx {
             /** Total PE threshold. */
             double totalPEThreshold_{8};
 
+            /** Threshold on the total PE of the back Hcal, disabled by default. */
+            double backPEThreshold_{std::numeric_limits<double>::infinity()};
+
+            /** Threshold on the total PE of the side Hcal, disabled by default. */
+            double sidePEThreshold_{std::numeric_limits<double>::infinity()};
+
+            /** Threshold on the PE of a single hit, disabled by default. */
+            double maxPEThreshold_{std::numeric_limits<double>::infinity()};
+
+            /** Start of the time window of the hits considered by the veto [ns]. */
+            double minTime_{-std::numeric_limits<double>::max()};
+
+            /** End of the time window of the hits considered by the veto [ns]. */
+            double maxTime_{std::numeric_limits<double>::max()};
+
     }; // HcalVetoProcessor
 }
 
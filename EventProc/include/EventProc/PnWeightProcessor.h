@@ -27,21 +27,20 @@
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <vector>
 
 //----------//
 //   LDMX   //
 //----------//
+#include "Event/EventConstants.h"
 #include "Event/PnWeightResult.h"
 #include "Event/SimParticle.h"
+#include "Event/TruthSummary.h"
 #include "Framework/EventProcessor.h"
 
 //----------//
 //   ROOT   //
 //----------//
-#include "TTree.h"
-#include "TFile.h"
-#include "TF1.h"
-#include "TH1F.h"
 #include "TClonesArray.h"
 
 namespace ldmx {
@@ -89,6 +88,20 @@ namespace ldmx {
              */
             double calculateW(SimParticle* particle, double delta = 0.5);
 
+            /**
+             * Calculate the measured W from the momentum and kinetic energy
+             * of a particle.
+             *
+             * @param p The total momentum of the particle.
+             * @param pz The z component of the momentum.
+             * @param ke The kinetic energy of the particle.
+             * @param delta The weight of the momentum along z.
+             * @return W
+             */
+            double calculateW(double p, double pz, double ke, double delta = 0.5) { 
+                return 0.5*(p + ke)*(sqrt(1 + (delta*delta)) - delta*(pz/p));
+            }
+
         private:
     
             /** Object used to persit weights. */
@@ -100,11 +113,23 @@ namespace ldmx {
             /** Minimum angle for backwards-going hadron. */
             double thetaThreshold_{100 /* degrees */};
             
-            /** Fit to lower slope of inclusive W (theta > 100) plot. */
-            TF1* lFit{new TF1{"lfit","exp([1]-[0]*x)", 950, 1150}};  
+            /** 
+             * Slope of the ratio of the exponentials of the fits to the 
+             * lower slope and to the high tail of the inclusive W plot. 
+             */
+            double expSlope_{0}; 
+
+            /** 
+             * Intercept of the ratio of the exponentials of the fits to the 
+             * lower slope and to the high tail of the inclusive W plot. 
+             */
+            double expIntercept_{0}; 
 
-            /** Fit to high tail of inclusive W (theta > 100) plot. */
-            TF1* hFit{nullptr}; 
+            /** 
+             * Coefficients of the polynomial of the fit to the high tail of 
+             * the inclusive W plot, in increasing order. 
+             */
+            std::vector<double> hFitPolynomial_; 
                 
     };
 }
@@ -9,19 +9,29 @@
 
 // STL
 #include <string>
+#include <vector>
+
+// ROOT
+#include "TClonesArray.h"
 
 // LDMX
 #include "Event/EventConstants.h"
+#include "Event/SortedHitIndices.h"
 #include "Framework/EventProcessor.h"
 
 namespace ldmx {
 
     /**
      * @class SimHitSortProcessor
-     * @brief 
+     * @brief Sorts the hits of a SimCalorimeterHit collection
      *
      * @note
-     * 
+     * The hits are not copied; the processor adds a collection with one
+     * SortedHitIndices object holding the indices of the hits in sorted order
+     * to the event.  The indices are swapped into that object, so they are not
+     * copied either.  The hits
+     * can be sorted by decreasing energy deposition ("edep"), or by 
+     * increasing time ("time") or detector ID ("detID").
      */
     class SimHitSortProcessor : public Producer {
 
@@ -38,22 +48,59 @@ namespace ldmx {
             /**
              * Class destructor.
              */
-            virtual ~SimHitSortProcessor() {;}
+            virtual ~SimHitSortProcessor() {
+                delete sortedHits_;
+            }
 
             /**
+             * Read the names of the input and output collections and the
+             * hit variable to sort by.
+             * @param pSet The parameters of the processor.
              */
             virtual void configure(const ParameterSet& pSet);
 
             /**
-             * description...
+             * Sort the hits and add their sorted indices to the event.
+             * @param event The event to process.
              */
             virtual void produce(Event& event);
 
         private:
-            
-            TClonesArray *sortedHits;
+
+            /** The hit variables that can be sorted by. */
+            enum SortVariable {
+                EDEP,
+                TIME,
+                DETID
+            };
+
+            /**
+             * Sort the indices of the hits by increasing value of a key.
+             * @param keys The sort key of each hit.
+             */
+            template<typename T> 
+            void sortIndices(const std::vector<T>& keys);
+
             std::string collectionName;
             std::string outputCollection;
+
+            /** The name of the hit variable to sort by. */
+            std::string sortBy_;
+
+            /** The hit variable to sort by. */
+            SortVariable sortVariable_{EDEP};
+
+            /** The sort keys of the hits, for floating point variables. */
+            std::vector<float> floatKeys_;
+
+            /** The sort keys of the hits, for integer variables. */
+            std::vector<int> intKeys_;
+
+            /** The indices of the hits, in sorted order after sorting. */
+            std::vector<int> indices_;
+
+            /** The collection holding the sorted indices added to the event. */
+            TClonesArray* sortedHits_{nullptr};
     };
 
 }
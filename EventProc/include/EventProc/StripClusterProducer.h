@@ -0,0 +1,145 @@
+/**
+ * @file StripClusterProducer.h
+ * @brief Processor that clusters the recoil tracker Si strip hits of
+ *        neighboring strips.
+ */
+
+#ifndef EVENTPROC_STRIPCLUSTERPRODUCER_H_
+#define EVENTPROC_STRIPCLUSTERPRODUCER_H_
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <string>
+#include <vector>
+
+//----------//
+//   ROOT   //
+//----------//
+#include "TClonesArray.h"
+
+//----------//
+//   LDMX   //
+//----------//
+#include "Event/SimTrackerHit.h"
+#include "Event/SiStripHit.h"
+#include "Framework/EventProcessor.h"
+
+namespace ldmx {
+
+    /**
+     * @class StripClusterProducer
+     * @brief Clusters the Si strip hits of neighboring strips
+     *
+     * @note
+     * The strip of each sim hit is found from its position projected on the
+     * measurement direction of its layer.  The hits are sorted by sensor and
+     * strip once, after which a single sweep merges the runs of hits in
+     * neighboring strips of the same sensor into clusters.  The buffer of
+     * sorted hits is kept between events so that no memory is allocated per
+     * hit.
+     */
+    class StripClusterProducer : public Producer {
+
+        public:
+
+            /** Constructor */
+            StripClusterProducer(const std::string &name, Process &process);
+
+            /** Destructor */
+            ~StripClusterProducer();
+
+            /**
+             * Configure the processor using the given user specified parameters.
+             *
+             * @param pSet Set of parameters used to configure this processor.
+             */
+            void configure(const ParameterSet &pSet);
+
+            /**
+             * Run the processor and create a collection of clustered Si strip
+             * hits.
+             *
+             * @param event The event to process.
+             */
+            void produce(Event &event);
+
+        private:
+
+            /** Number of layers with a configurable stereo angle. */
+            static const int MAX_LAYERS{32};
+
+            /** A sim hit and its strip, in the buffer which is sorted. */
+            struct StripEntry {
+
+                /** Layer ID of the sensor. */
+                int layer;
+
+                /** Module ID of the sensor. */
+                int module;
+
+                /** Index of the strip within the sensor. */
+                int strip;
+
+                /** Index of the hit in the order it was read. */
+                int order;
+
+                /** The sim hit. */
+                SimTrackerHit* hit;
+
+                /** Order the hits by sensor, strip and read order. */
+                bool operator<(const StripEntry &other) const {
+                    if (layer != other.layer) return layer < other.layer;
+                    if (module != other.module) return module < other.module;
+                    if (strip != other.strip) return strip < other.strip;
+                    return order < other.order;
+                }
+            };
+
+            /**
+             * Add a sim hit to the buffer of hits to cluster.
+             *
+             * @param hit The sim hit.
+             */
+            void addEntry(SimTrackerHit* hit);
+
+            /**
+             * Fill a cluster from a run of sorted hits.
+             *
+             * @param cluster The cluster to fill.
+             * @param begin Index of the first hit of the run in the buffer.
+             * @param end Index past the last hit of the run in the buffer.
+             */
+            void fillCluster(SiStripHit* cluster, std::size_t begin, std::size_t end) const;
+
+            /** Name of the collection of Si strip hits to cluster. */
+            std::string inputCollection_{"SiStripHits"};
+
+            /** Name of the collection of clusters. */
+            std::string outputCollection_{"SiStripClusters"};
+
+            /** Strip pitch [mm]. */
+            double stripPitch_{0.06};
+
+            /**
+             * Largest number of strips without a hit between two hits of the
+             * same cluster.
+             */
+            int maxStripGap_{0};
+
+            /** Cosine of the stereo angle of each layer, indexed by layer ID. */
+            std::vector<double> stereoCos_;
+
+            /** Sine of the stereo angle of each layer, indexed by layer ID. */
+            std::vector<double> stereoSin_;
+
+            /** Buffer of the hits of an event, reused between events. */
+            std::vector<StripEntry> entries_;
+
+            /** Collection of clustered Si strip hits. */
+            TClonesArray* clusters_{nullptr};
+
+    }; // StripClusterProducer
+}
+
+#endif // EVENTPROC_STRIPCLUSTERPRODUCER_H_
@@ -12,6 +12,7 @@
 //   C++ StdLib   //
 //----------------//
 #include <time.h>
+#include <vector>
 
 //----------//
 //   ROOT   //
@@ -53,8 +54,29 @@ namespace ldmx {
              */
             void produce(Event &event); 
 
+            /** Print the number of dropped hits per layer at the end of the job. */
+            void onProcessEnd(); 
+
         private: 
 
+            /** Number of layers in the efficiency map. */
+            static const int MAX_LAYERS{32};
+
+            /** Number of sensors per layer in the efficiency map. */
+            static const int MAX_SENSORS{32};
+
+            /**
+             * Get the efficiency of the sensor of a hit.
+             *
+             * @param layer The layer ID of the hit.
+             * @param sensor The module ID of the hit.
+             * @return The efficiency, in the range 0-1.
+             */
+            double getEfficiency(int layer, int sensor) const { 
+                if (layer < 0 || layer >= MAX_LAYERS || sensor < 0 || sensor >= MAX_SENSORS) return hitEff_;
+                return efficiencies_[layer*MAX_SENSORS + sensor]; 
+            }
+
             /** 
              * Random number generator used to determine if hit should be
              * dropped. 
@@ -64,10 +86,17 @@ namespace ldmx {
             /** Collection of digitized tracker strip hits. */
             TClonesArray* siStripHits_{nullptr};
 
-            /** 
-             * Hit efficiency. For now, this is an integer in the range 0-100.
-             */
-            int hitEff_{99};
+            /** Default hit efficiency, in the range 0-1. */
+            double hitEff_{0.99};
+
+            /** Hit efficiency of each sensor, indexed by [layer ID][module ID]. */
+            std::vector<double> efficiencies_;
+
+            /** Number of hits processed per layer. */
+            std::vector<long> hitCounts_;
+
+            /** Number of hits dropped per layer. */
+            std::vector<long> droppedCounts_;
 
     }; // TrackerHitKiller
 }
@@ -7,7 +7,11 @@
 #ifndef EVENTPROC_TRIGGERPROCESSOR_H_
 #define EVENTPROC_TRIGGERPROCESSOR_H_
 
+// STL
+#include <vector>
+
 // LDMX
+#include "DetDescr/EcalHexReadout.h"
 #include "Event/TriggerResult.h"
 #include "Framework/EventProcessor.h"
 
@@ -19,10 +23,24 @@ namespace ldmx {
      *
      * @note
      * TriggerProcessor takes in a set of parameters to be used in defining
-     * the trigger algorithm. An event is passed to the processor and the relevant
-     * algorithms are then run on the event (ECAL layer sum). A trigger decision is
-     * executed and the decision along with the algorithm name and relevant variables
-     * are stored in a TriggerResult object which is added to the collection.
+     * the trigger algorithms. All algorithms (ECAL layer sum, center tower sum
+     * and total energy) are evaluated in a single pass over the ECAL digis.
+     * The trigger decision is taken by the algorithm selected with the mode,
+     * and the decision along with the algorithm name and the sums of every
+     * algorithm are stored in a TriggerResult object which is added to the 
+     * collection.  The variables of the TriggerResult are
+     *
+     *  0. layer sum between the start and end layers 
+     *  1. layer sum threshold
+     *  2. number of layers in the layer sum
+     *  3. center tower sum between the start and end layers
+     *  4. center tower threshold
+     *  5. total energy
+     *  6. total energy threshold
+     *  7. bit mask of the algorithms passing their threshold (bit = mode)
+     *  8. and up, the energy sum of each layer
+     *
+     * so that other thresholds and layer ranges can be studied offline.
      */
     class TriggerProcessor : public Producer {
 
@@ -49,6 +67,15 @@ namespace ldmx {
              */
             virtual void configure(const ParameterSet& pSet);
 
+            /**
+             * Rebuild the center tower from the hex readout of the new run, with
+             * the ECal geometry stored in its header or, for older runs, known
+             * for its detector.
+             * @param runHeader The header of the new run.
+             * @throw Exception if the ECal geometry of the run is unknown.
+             */
+            virtual void onNewRun(const RunHeader& runHeader);
+
             /**
              * Run the trigger algorithm and create a TriggerResult
              * object to contain info about the trigger decision
@@ -58,17 +85,59 @@ namespace ldmx {
              */
             virtual void produce(Event& event);
 
+            /** The trigger algorithms, numbered by their mode. */
+            enum TriggerMode {
+                LAYER_SUM = 0,
+                CENTER_TOWER = 1,
+                TOTAL_ENERGY = 2,
+                N_TRIGGER_MODES = 3
+            };
+
+            /** Maximum number of ECAL layers summed by the trigger. */
+            static const int MAX_LAYERS{34};
+
+            /** Index of the first per-layer sum in the TriggerResult variables. */
+            static const int LAYER_VARS_OFFSET{8};
+
         private:
 
+            /**
+             * Flag the cells of the center module which are in the center 
+             * tower of a hex readout.
+             * @param hexReadout The hex readout.
+             */
+            void buildCenterTower(const EcalHexReadout& hexReadout);
+
             /** The energy sum to make cut on. */
             float layerESumCut_{0};
 
+            /** The center tower sum to make cut on. */
+            float centerTowerCut_{0};
+
+            /** The total energy to make cut on. */
+            float totalECut_{0};
+
             /** The trigger mode to run in. Mode zero sums over
-             * all cells in layer, while in mode 1 only cells in
-             * center module are summed over. (TODO)
+             * all cells in layer, mode 1 only sums over the cells 
+             * in the center tower and mode 2 sums over all layers.
              */
             int mode_{0};
 
+            /** 
+             * Flags of the cells of the center module which are in the 
+             * center tower, indexed by cell ID. 
+             */
+            std::vector<bool> centerTowerCells_;
+
+            /** Radius of the center tower [mm]. */
+            double centerTowerRadius_{40.0};
+
+            /** Energy sums of each layer, reset every event. */
+            double layerE_[MAX_LAYERS];
+
+            /** Center tower energy sums of each layer, reset every event. */
+            double layerTowerE_[MAX_LAYERS];
+
             /** The first layer of layer sum. */
             int startLayer_{0};
 
@@ -0,0 +1,126 @@
+/**
+ * @file TruthSummaryProducer.h
+ * @brief Processor that summarizes the Monte Carlo truth of an event for
+ *        downstream processors.
+ */
+
+#ifndef EVENTPROC_TRUTHSUMMARYPRODUCER_H_
+#define EVENTPROC_TRUTHSUMMARYPRODUCER_H_
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <string>
+#include <utility>
+#include <vector>
+
+//----------//
+//   LDMX   //
+//----------//
+#include "Event/EventConstants.h"
+#include "Event/SimCalorimeterHit.h"
+#include "Event/SimParticle.h"
+#include "Event/TruthSummary.h"
+#include "Framework/EventProcessor.h"
+
+//----------//
+//   ROOT   //
+//----------//
+#include <TClonesArray.h>
+
+namespace ldmx { 
+
+    /**
+     * @class TruthSummaryProducer
+     * @brief Summarizes the Monte Carlo truth of an event 
+     *
+     * @note
+     * The recoil electron, the photonuclear gamma, the hardest photonuclear 
+     * nucleon and the ECal sim hits of each particle are found once per 
+     * event and stored in a TruthSummary, so that downstream processors 
+     * don't each have to scan the sim particles and resolve the references
+     * of the hit contributions.
+     */
+    class TruthSummaryProducer : public Producer { 
+        
+        public: 
+
+            /** Proton PDG ID */
+            static const int PROTON_PDGID{2212}; 
+
+            /** Neutron PDG ID */
+            static const int NEUTRON_PDGID{2112}; 
+
+            /** Constructor */
+            TruthSummaryProducer(const std::string &name, Process &process); 
+
+            /** Destructor */
+            ~TruthSummaryProducer();
+
+            /** 
+             * Configure the processor using the given user specified parameters.
+             * 
+             * @param pSet Set of parameters used to configure this processor.
+             */
+            void configure(const ParameterSet &pSet); 
+
+            /**
+             * Run the processor and add the truth summary to the event.
+             *
+             * @param event The event to process.
+             */
+            void produce(Event &event); 
+
+        private:
+
+            /**
+             * Get the index of a sim particle in the collection of sim 
+             * particles.
+             *
+             * @param simParticle The sim particle.
+             * @return The index of the particle or -1 if it isn't in the 
+             *         collection of sim particles.
+             */
+            int getParticleIndex(const SimParticle* simParticle) const;
+
+            /**
+             * Find the photonuclear gamma and the hardest photonuclear 
+             * nucleon among the daughters of the recoil electron.
+             *
+             * @param simParticles The collection of sim particles.
+             */
+            void findPnParticles(const TClonesArray* simParticles);
+
+            /**
+             * Build the lists of ECal sim hits each particle contributed to.
+             *
+             * @param ecalSimHits The collection of ECal sim hits.
+             * @param nParticles The number of sim particles.
+             */
+            void buildEcalHitLists(const TClonesArray* ecalSimHits, int nParticles);
+
+            /** Name of the collection of ECal sim hits. */
+            std::string ecalSimHitCollection_{EventConstants::ECAL_SIM_HITS};
+
+            /** 
+             * Sim particles sorted by address along with their index in the 
+             * collection of sim particles. 
+             */
+            std::vector<std::pair<const SimParticle*, int>> particleIndices_;
+
+            /** Particle index of each contribution of the ECal sim hits, in order. */
+            std::vector<int> contribParticles_;
+
+            /** Start of the ECal hit list of each particle. */
+            std::vector<int> hitOffsets_;
+
+            /** ECal hit lists of all particles. */
+            std::vector<int> hitIndices_;
+
+            /** The summary added to the event. */
+            TruthSummary summary_;
+
+    }; // TruthSummaryProducer
+}
+
+#endif // EVENTPROC_TRUTHSUMMARYPRODUCER_H_
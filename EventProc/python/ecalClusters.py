@@ -0,0 +1,17 @@
+#!/usr/bin/python
+
+from LDMX.Framework import ldmxcfg
+
+# clusters neighboring ECal digis in three dimensions
+ecalClusters = ldmxcfg.Producer("ecalClusters", "ldmx::EcalClusterProducer")
+ecalClusters.parameters["digi_collection"] = "ecalDigis"
+ecalClusters.parameters["cluster_collection"] = "ecalClusters"
+ecalClusters.parameters["min_hit_energy"] = 0.0 # MeV
+ecalClusters.parameters["min_cluster_energy"] = 0.0 # MeV
+ecalClusters.parameters["min_cluster_hits"] = 1
+# hits up to this many layers apart in the same or nearest neighbor cells are neighbors
+ecalClusters.parameters["max_layer_gap"] = 1
+# also treat next-to-nearest neighbor cells in a layer as neighbors
+ecalClusters.parameters["use_nnn"] = 0
+# optional file caching the ECal hex readout geometry, written if it doesn't exist
+ecalClusters.parameters["hex_readout_cache"] = ""
@@ -15,3 +15,13 @@ ecalDigis.parameters["padCapacitance"] = 27.56
 
 # set the readout threshold in multiples of RMS noise
 ecalDigis.parameters["readoutThreshold"] = 4.
+
+# set the base seed of the noise generators (0 = seed from the clock)
+ecalDigis.parameters["randomSeed"] = 0
+
+# optional file caching the ECal hex readout geometry, written if it doesn't exist
+ecalDigis.parameters["hexReadoutCache"] = ""
+
+# optional per-channel conditions file (gain, pedestal, noise, dead/hot flags)
+# indexed by channel index, made with ldmx-make-conditions
+ecalDigis.parameters["conditionsFile"] = ""
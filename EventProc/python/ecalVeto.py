@@ -7,3 +7,5 @@ ecalVeto.parameters["num_ecal_layers"] = 34
 ecalVeto.parameters["do_bdt"] = 1
 ecalVeto.parameters["bdt_file"] = "cal_bdt.pkl" 
 ecalVeto.parameters["disc_cut"] = 0.999672
+# optional file caching the ECal hex readout geometry, written if it doesn't exist
+ecalVeto.parameters["hex_readout_cache"] = ""
@@ -10,3 +10,16 @@ hcalDigis.parameters["mev_per_mip"] = 1.4
 hcalDigis.parameters["pe_per_mip"] = 13.5
 hcalDigis.parameters["doStrip"] = 0
 
+# strip readout: light is attenuated and delayed on its way to both ends
+# of the strips, lengths and times are in mm and ns
+hcalDigis.parameters["back_strip_length"] = 3100.
+hcalDigis.parameters["side_strip_length"] = 290.
+hcalDigis.parameters["side_strip_center_z"] = 345.
+hcalDigis.parameters["strip_position_bins"] = 64
+hcalDigis.parameters["attenuation_length"] = 5000.
+hcalDigis.parameters["light_velocity"] = 187.
+hcalDigis.parameters["time_resolution"] = 0.5
+
+# optional per-channel conditions file (gain, pedestal in PE, noise RMS in PE, dead/hot
+# flags) indexed by layer + 256*(section + 8*strip), made with ldmx-make-conditions
+hcalDigis.parameters["conditions_file"] = ""
@@ -10,3 +10,9 @@ simpleTrigger.parameters["threshold"] = 1500.0
 simpleTrigger.parameters["mode"] = 0
 simpleTrigger.parameters["start_layer"] = 1
 simpleTrigger.parameters["end_layer"] = 20
+
+# thresholds of the center tower (cells of the center module within the
+# tower radius in mm) and total energy algorithms, mode 1 and 2 respectively
+simpleTrigger.parameters["center_tower_threshold"] = 1500.0
+simpleTrigger.parameters["center_tower_radius"] = 40.0
+simpleTrigger.parameters["total_energy_threshold"] = 3000.0
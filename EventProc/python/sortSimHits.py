@@ -7,9 +7,11 @@ from LDMX.Framework import ldmxcfg
 ecalSimHitSort = ldmxcfg.Producer("ecalSimHitSort", "ldmx::SimHitSortProcessor")
 ecalSimHitSort.parameters["simHitCollection"]="EcalSimHits"
 ecalSimHitSort.parameters["outputCollection"]="SortedEcalSimHits"
+ecalSimHitSort.parameters["sortBy"]="edep"
 hcalSimHitSort = ldmxcfg.Producer("hcalSimHitSort", "ldmx::SimHitSortProcessor")
 hcalSimHitSort.parameters["simHitCollection"]="HcalSimHits"
 hcalSimHitSort.parameters["outputCollection"]="SortedHcalSimHits"
+hcalSimHitSort.parameters["sortBy"]="edep"
 
 p = ldmxcfg.Process("sort")
 p.libraries.append("ldmx-sw-install/lib/libEventProc.so")
@@ -0,0 +1,13 @@
+#!/usr/bin/python
+
+from LDMX.Framework import ldmxcfg
+
+# clusters the Si strip hits of neighboring strips of each recoil sensor
+stripClusters = ldmxcfg.Producer("stripClusters", "ldmx::StripClusterProducer")
+stripClusters.parameters["input_collection"] = "SiStripHits"
+stripClusters.parameters["output_collection"] = "SiStripClusters"
+stripClusters.parameters["strip_pitch"] = 0.06 # mm
+# number of strips without a hit allowed inside a cluster
+stripClusters.parameters["max_strip_gap"] = 0
+# stereo angle of each layer in radians, starting with layer 1
+stripClusters.parameters["layer_stereo_angles"] = [0.0, 0.1, 0.0, -0.1, 0.0, 0.1, 0.0, -0.1]
@@ -6,3 +6,10 @@ trackerHitKiller = ldmxcfg.Producer("trackerHitKiller", "ldmx::TrackerHitKiller"
 
 # Configure
 trackerHitKiller.parameters['hitEfficiency'] = 99.0
+
+# Efficiencies in percent overriding hitEfficiency, per layer starting with
+# layer 1, and per sensor given by its layer and module IDs
+trackerHitKiller.parameters['layerEfficiencies'] = []
+trackerHitKiller.parameters['sensorEfficiencyLayers'] = []
+trackerHitKiller.parameters['sensorEfficiencyModules'] = []
+trackerHitKiller.parameters['sensorEfficiencies'] = []
@@ -0,0 +1,8 @@
+#!/usr/bin/python
+
+from LDMX.Framework import ldmxcfg
+
+# summarizes the recoil electron, PN gamma, hardest PN nucleon and the ECal
+# hits of each particle, must run before the processors which use it
+truthSummary = ldmxcfg.Producer("truthSummary", "ldmx::TruthSummaryProducer")
+truthSummary.parameters["ecal_sim_hit_collection"] = "EcalSimHits"
@@ -0,0 +1,229 @@
+/**
+ * @file EcalClusterProducer.cxx
+ * @brief Processor that clusters neighboring ECal hits in three dimensions.
+ */
+
+#include "EventProc/EcalClusterProducer.h"
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <algorithm>
+#include <iostream>
+
+namespace ldmx {
+
+    const int EcalClusterProducer::NUM_ECAL_LAYERS;
+
+    const int EcalClusterProducer::CELLS_PER_LAYER;
+
+    EcalClusterProducer::EcalClusterProducer(const std::string& name, Process& process) :
+        Producer(name, process) {
+    }
+
+    EcalClusterProducer::~EcalClusterProducer() {
+    }
+
+    void EcalClusterProducer::configure(const ParameterSet &pSet) {
+
+        digiCollection_ = pSet.getString("digi_collection", digiCollection_);
+        clusterCollection_ = pSet.getString("cluster_collection", clusterCollection_);
+        minHitEnergy_ = pSet.getDouble("min_hit_energy", minHitEnergy_);
+        minClusterEnergy_ = pSet.getDouble("min_cluster_energy", minClusterEnergy_);
+        minClusterHits_ = pSet.getInteger("min_cluster_hits", minClusterHits_);
+        maxLayerGap_ = pSet.getInteger("max_layer_gap", maxLayerGap_);
+        useNNN_ = pSet.getInteger("use_nnn", useNNN_);
+
+        if (maxLayerGap_ < 0) {
+            EXCEPTION_RAISE("EcalClusterProducer", "The maximum layer gap can't be negative.");
+        }
+
+        // the hex readout is replaced by the readout of the run's detector in onNewRun()
+        hexReadoutCache_ = pSet.getString("hex_readout_cache", "");
+        hexReadout_ = &EcalHexReadout::getInstance(EcalHexReadout::defaultMinR, EcalHexReadout::defaultGap_,
+                EcalHexReadout::defaultNCellsWide, hexReadoutCache_);
+        buildNeighborTable();
+
+        channelHits_.assign(NUM_ECAL_LAYERS*CELLS_PER_LAYER, -1);
+
+        clusters_ = new TClonesArray("ldmx::EcalCluster", 100);
+    }
+
+    void EcalClusterProducer::onNewRun(const RunHeader& runHeader) {
+        const EcalHexReadout* hexReadout{nullptr};
+        try {
+            hexReadout = &EcalHexReadout::getInstance(EcalHexReadout::getRunGeometry(runHeader.getDetectorName(),
+                        runHeader.getFloatParameter(EventConstants::ECAL_HEX_RADIUS),
+                        runHeader.getFloatParameter(EventConstants::ECAL_HEX_GAP)), hexReadoutCache_);
+        } catch (const std::invalid_argument& e) {
+            EXCEPTION_RAISE("EcalClusterProducer", e.what());
+        }
+        if (hexReadout != hexReadout_) {
+            hexReadout_ = hexReadout;
+            buildNeighborTable();
+        }
+    }
+
+    void EcalClusterProducer::buildNeighborTable() {
+
+        // The cell index assumes a fixed number of cells per module, so
+        // make sure it agrees with the hex readout.
+        if (hexReadout_->getCellPositionMap().size() != CELLS_PER_HEX_MODULE) {
+            EXCEPTION_RAISE("EcalClusterProducer",
+                    "The hex readout has " + std::to_string(hexReadout_->getCellPositionMap().size())
+                    + " cells per module but " + std::to_string(CELLS_PER_HEX_MODULE) + " were expected.");
+        }
+
+        // The neighbors of each cell are stored nearest neighbors first,
+        // so the nearest neighbors alone are a prefix of the list
+        neighborOffsets_.assign(1, 0);
+        neighborCells_.clear();
+        nnEnds_.clear();
+        cellX_.clear();
+        cellY_.clear();
+        for (int moduleID = 0; moduleID < HEX_MODULES_PER_LAYER; ++moduleID) {
+            for (int cellID = 0; cellID < CELLS_PER_HEX_MODULE; ++cellID) {
+                int cellModuleID = hexReadout_->combineID(cellID, moduleID);
+                for (int neighborID : hexReadout_->getNN(cellModuleID)) {
+                    std::pair<int, int> neighbor = hexReadout_->separateID(neighborID);
+                    neighborCells_.push_back(neighbor.second*CELLS_PER_HEX_MODULE + neighbor.first);
+                }
+                nnEnds_.push_back(neighborCells_.size());
+                for (int neighborID : hexReadout_->getNNN(cellModuleID)) {
+                    std::pair<int, int> neighbor = hexReadout_->separateID(neighborID);
+                    neighborCells_.push_back(neighbor.second*CELLS_PER_HEX_MODULE + neighbor.first);
+                }
+                neighborOffsets_.push_back(neighborCells_.size());
+
+                XYCoords position = hexReadout_->getCellCenterAbsolute(cellModuleID);
+                cellX_.push_back(position.first);
+                cellY_.push_back(position.second);
+            }
+        }
+    }
+
+    void EcalClusterProducer::merge(int hitA, int hitB) {
+        int rootA = findRoot(hitA);
+        int rootB = findRoot(hitB);
+        if (rootA == rootB) return;
+        if (setSizes_[rootA] < setSizes_[rootB]) std::swap(rootA, rootB);
+        parents_[rootB] = rootA;
+        setSizes_[rootA] += setSizes_[rootB];
+    }
+
+    void EcalClusterProducer::produce(Event& event) {
+
+        const TClonesArray* ecalDigis = event.getCollection(digiCollection_);
+        int nDigis = ecalDigis->GetEntriesFast();
+
+        // Give each hit above threshold a slot, and record the slot in its
+        // channel.  Hits sharing a channel are merged right away.
+        hitChannels_.clear();
+        hitIndices_.clear();
+        hitEnergies_.clear();
+        parents_.clear();
+        setSizes_.clear();
+        for (int iDigi = 0; iDigi < nDigis; ++iDigi) {
+            EcalHit* hit = static_cast<EcalHit*>(ecalDigis->At(iDigi));
+            if (hit->getEnergy() <= minHitEnergy_) continue;
+
+            int layer = hit->getLayer();
+            int cell = getLayerCellIndex(hit->getID());
+            if (layer < 0 || layer >= NUM_ECAL_LAYERS || cell >= CELLS_PER_LAYER) continue;
+
+            int slot = hitIndices_.size();
+            int channel = layer*CELLS_PER_LAYER + cell;
+            hitChannels_.push_back(channel);
+            hitIndices_.push_back(iDigi);
+            hitEnergies_.push_back(hit->getEnergy());
+            parents_.push_back(slot);
+            setSizes_.push_back(1);
+            if (channelHits_[channel] >= 0) merge(slot, channelHits_[channel]);
+            else channelHits_[channel] = slot;
+        }
+        int nHits = hitIndices_.size();
+
+        // Merge each hit with its neighbors in the same layer and in the
+        // layers before it.  The neighbors in later layers are found when
+        // those layers' hits are visited.
+        for (int slot = 0; slot < nHits; ++slot) {
+            int layer = hitChannels_[slot]/CELLS_PER_LAYER;
+            int cell = hitChannels_[slot] % CELLS_PER_LAYER;
+            int layerStart = layer*CELLS_PER_LAYER;
+
+            int end = useNNN_ ? neighborOffsets_[cell + 1] : nnEnds_[cell];
+            for (int iNeighbor = neighborOffsets_[cell]; iNeighbor < end; ++iNeighbor) {
+                int neighborSlot = channelHits_[layerStart + neighborCells_[iNeighbor]];
+                if (neighborSlot >= 0) merge(slot, neighborSlot);
+            }
+
+            for (int otherLayer = std::max(layer - maxLayerGap_, 0); otherLayer < layer; ++otherLayer) {
+                int otherStart = otherLayer*CELLS_PER_LAYER;
+                int neighborSlot = channelHits_[otherStart + cell];
+                if (neighborSlot >= 0) merge(slot, neighborSlot);
+                for (int iNeighbor = neighborOffsets_[cell]; iNeighbor < nnEnds_[cell]; ++iNeighbor) {
+                    neighborSlot = channelHits_[otherStart + neighborCells_[iNeighbor]];
+                    if (neighborSlot >= 0) merge(slot, neighborSlot);
+                }
+            }
+        }
+
+        // Total up the energy of each set and number the sets passing the
+        // cluster requirements
+        setEnergies_.assign(nHits, 0);
+        for (int slot = 0; slot < nHits; ++slot) setEnergies_[findRoot(slot)] += hitEnergies_[slot];
+
+        rootClusters_.assign(nHits, -1);
+        int nClusters = 0;
+        for (int slot = 0; slot < nHits; ++slot) {
+            if (parents_[slot] != slot) continue;
+            if (setSizes_[slot] < minClusterHits_ || setEnergies_[slot] < minClusterEnergy_) continue;
+            EcalCluster* cluster = static_cast<EcalCluster*>(clusters_->ConstructedAt(nClusters));
+            cluster->setLayerRange(NUM_ECAL_LAYERS, -1);
+            rootClusters_[slot] = nClusters;
+            ++nClusters;
+        }
+
+        // Fill the clusters.  The centroid and mean layer are energy 
+        // weighted sums until every hit has been added.
+        for (int slot = 0; slot < nHits; ++slot) {
+            int root = findRoot(slot);
+            if (rootClusters_[root] < 0) continue;
+            EcalCluster* cluster = static_cast<EcalCluster*>(clusters_->At(rootClusters_[root]));
+
+            float energy = hitEnergies_[slot];
+            int layer = hitChannels_[slot]/CELLS_PER_LAYER;
+            int cell = hitChannels_[slot] % CELLS_PER_LAYER;
+
+            cluster->setCentroidXY(cluster->getCentroidX() + energy*cellX_[cell], 
+                    cluster->getCentroidY() + energy*cellY_[cell]);
+            cluster->setMeanLayer(cluster->getMeanLayer() + energy*layer);
+            cluster->setLayerRange(std::min(cluster->getFirstLayer(), layer), 
+                    std::max(cluster->getLastLayer(), layer));
+            if (cluster->getSeedIndex() < 0 || energy > cluster->getEnergy()) {
+                cluster->setSeedIndex(hitIndices_[slot]);
+                cluster->setEnergy(energy);
+            }
+            cluster->addHitIndex(hitIndices_[slot]);
+        }
+
+        // The energy holds the seed energy while filling, set the totals
+        for (int slot = 0; slot < nHits; ++slot) {
+            if (rootClusters_[slot] < 0) continue;
+            EcalCluster* cluster = static_cast<EcalCluster*>(clusters_->At(rootClusters_[slot]));
+            float energy = setEnergies_[slot];
+            if (energy > 0) {
+                cluster->setCentroidXY(cluster->getCentroidX()/energy, cluster->getCentroidY()/energy);
+                cluster->setMeanLayer(cluster->getMeanLayer()/energy);
+            }
+            cluster->setEnergy(energy);
+        }
+
+        // Reset only the channels which were used
+        for (int slot = 0; slot < nHits; ++slot) channelHits_[hitChannels_[slot]] = -1;
+
+        event.add(clusterCollection_, clusters_);
+    }
+}
+
+DECLARE_PRODUCER_NS(ldmx, EcalClusterProducer)
@@ -7,17 +7,60 @@
 
 #include "EventProc/EcalDigiProducer.h"
 
+// STL
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <utility>
+
 namespace ldmx {
 
-    const std::vector<double> LAYER_WEIGHTS 
-        = {1.641, 3.526, 5.184, 6.841,
-        8.222, 8.775, 8.775, 8.775, 8.775, 8.775, 8.775, 8.775, 8.775, 8.775,
-        8.775, 8.775, 8.775, 8.775, 8.775, 8.775, 8.775, 8.775, 12.642, 16.51,
-        16.51, 16.51, 16.51, 16.51, 16.51, 16.51, 16.51, 16.51, 8.45}; 
-   
-    const double EcalDigiProducer::ELECTRONS_PER_MIP = 33000.0; // e-
+    constexpr double EcalDigiProducer::ELECTRONS_PER_MIP;
+
+    constexpr double EcalDigiProducer::MIP_SI_RESPONSE;
+
+    /** 
+     * Convert a layer's sampling weight into the factor that takes a raw 
+     * energy deposit to a calibrated energy, 
+     *     E = ((E_raw/MIP_SI_RESPONSE)*weight + E_raw)*0.948.
+     */
+    static constexpr double layerCalibration(double layerWeight) { 
+        return (layerWeight/EcalDigiProducer::MIP_SI_RESPONSE + 1.)*0.948; 
+    }
+
+    /** Per-layer calibration factors, indexed by layer number. */
+    static constexpr double LAYER_CALIBRATION[] 
+        = {layerCalibration(1.641), layerCalibration(3.526), layerCalibration(5.184), layerCalibration(6.841),
+        layerCalibration(8.222), layerCalibration(8.775), layerCalibration(8.775), layerCalibration(8.775), 
+        layerCalibration(8.775), layerCalibration(8.775), layerCalibration(8.775), layerCalibration(8.775), 
+        layerCalibration(8.775), layerCalibration(8.775), layerCalibration(8.775), layerCalibration(8.775), 
+        layerCalibration(8.775), layerCalibration(8.775), layerCalibration(8.775), layerCalibration(8.775), 
+        layerCalibration(8.775), layerCalibration(8.775), layerCalibration(12.642), layerCalibration(16.51),
+        layerCalibration(16.51), layerCalibration(16.51), layerCalibration(16.51), layerCalibration(16.51), 
+        layerCalibration(16.51), layerCalibration(16.51), layerCalibration(16.51), layerCalibration(16.51), 
+        layerCalibration(8.45)}; 
 
-    const double EcalDigiProducer::MIP_SI_RESPONSE = 0.130; // MeV
+    static_assert(sizeof(LAYER_CALIBRATION)/sizeof(double) == 33, 
+            "There must be one calibration factor per ECal layer."); 
+
+    /** 
+     * Mix a 64-bit value with the splitmix64 finalizer, so that nearby 
+     * inputs give unrelated outputs.
+     */
+    static uint64_t splitMix64(uint64_t value) { 
+        value += 0x9E3779B97F4A7C15ULL; 
+        value = (value ^ (value >> 30))*0xBF58476D1CE4E5B9ULL; 
+        value = (value ^ (value >> 27))*0x94D049BB133111EBULL; 
+        return value ^ (value >> 31); 
+    }
+
+    /** 
+     * Turn 32 bits of a hash into a TRandom3 seed, which must not be 0 
+     * since that would seed from the clock.
+     */
+    static unsigned int toSeed(uint32_t hash) { 
+        return hash == 0 ? 1 : hash; 
+    }
 
     EcalDigiProducer::EcalDigiProducer(const std::string& name, Process& process) :
         Producer(name, process) {
@@ -25,7 +68,11 @@ namespace ldmx {
 
     void EcalDigiProducer::configure(const ParameterSet& ps) {
 
-        hexReadout_ = new EcalHexReadout();
+        // the hex readout is shared with the other ECal processors, and
+        // replaced by the readout of the run's detector in onNewRun()
+        hexReadoutCache_ = ps.getString("hexReadoutCache", "");
+        hexReadout_ = &EcalHexReadout::getInstance(EcalHexReadout::defaultMinR, EcalHexReadout::defaultGap_, 
+                EcalHexReadout::defaultNCellsWide, hexReadoutCache_);
 
         noiseIntercept_ = ps.getDouble("noiseIntercept"); 
         noiseSlope_     = ps.getDouble("noiseSlope");
@@ -47,9 +94,83 @@ namespace ldmx {
         noiseGenerator_->setPedestal(0); 
         noiseGenerator_->setNoiseThreshold(ps.getDouble("readoutThreshold")*noiseRMS_); 
 
+        // A seed of 0 means the seed is taken from the clock once per job.
+        randomSeed_ = ps.getInteger("randomSeed", 0); 
+        if (randomSeed_ == 0) randomSeed_ = time(nullptr); 
+
+        buildChannelList(); 
+
+        // Per-channel gains, pedestals, noise and masks.  Without a 
+        // conditions file every channel has the nominal response.
+        conditions_ = &ChannelConditions::getInstance(ps.getString("conditionsFile", "")); 
+        maskedChannels_.reset(); 
+        for (int channelIndex = 0; channelIndex < TOTAL_CELLS; ++channelIndex) { 
+            if (conditions_->get(channelIndex).isMasked()) maskedChannels_.set(channelIndex); 
+        }
+        buildNoiseGroups(); 
+
         ecalDigis_ = new TClonesArray(EventConstants::ECAL_HIT.c_str(), 10000);
     }
 
+    void EcalDigiProducer::onNewRun(const RunHeader& runHeader) {
+        const EcalHexReadout* hexReadout{nullptr};
+        try {
+            hexReadout = &EcalHexReadout::getInstance(EcalHexReadout::getRunGeometry(runHeader.getDetectorName(),
+                        runHeader.getFloatParameter(EventConstants::ECAL_HEX_RADIUS),
+                        runHeader.getFloatParameter(EventConstants::ECAL_HEX_GAP)), hexReadoutCache_);
+        } catch (const std::invalid_argument& e) {
+            EXCEPTION_RAISE("EcalDigiProducer", e.what());
+        }
+        if (hexReadout != hexReadout_) {
+            hexReadout_ = hexReadout;
+            buildChannelList();
+        }
+    }
+
+    void EcalDigiProducer::buildChannelList() { 
+
+        // The channel index assumes a fixed number of cells per module, so 
+        // make sure it agrees with the hex readout.
+        if (hexReadout_->getCellPositionMap().size() != CELLS_PER_HEX_MODULE) { 
+            EXCEPTION_RAISE("EcalDigiProducer", 
+                    "The hex readout has " + std::to_string(hexReadout_->getCellPositionMap().size()) 
+                    + " cells per module but " + std::to_string(CELLS_PER_HEX_MODULE) + " were expected.");
+        }
+
+        channelIDs_.clear(); 
+        channelIDs_.reserve(TOTAL_CELLS); 
+        for (int layerID = 0; layerID < NUM_ECAL_LAYERS; ++layerID) { 
+            for (int moduleID = 0; moduleID < HEX_MODULES_PER_LAYER; ++moduleID) { 
+                for (int cellID = 0; cellID < CELLS_PER_HEX_MODULE; ++cellID) { 
+                    channelIDs_.push_back(EcalDetectorID::encode(0, layerID, moduleID, cellID)); 
+                }
+            }
+        }
+    }
+
+    void EcalDigiProducer::buildNoiseGroups() { 
+
+        // Group the unmasked channels by noise RMS and pedestal.  Without a
+        // conditions file this is a single group of all channels.
+        noiseGroups_.clear(); 
+        channelNoiseGroups_.assign(TOTAL_CELLS, -1); 
+        std::map<std::pair<double, double>, int> groupIndices; 
+        for (int channelIndex = 0; channelIndex < TOTAL_CELLS; ++channelIndex) { 
+            if (maskedChannels_.test(channelIndex)) continue; 
+            const ChannelCondition& condition = conditions_->get(channelIndex); 
+            std::pair<double, double> key(condition.noise < 0 ? noiseRMS_ : condition.noise, condition.pedestal); 
+            auto groupIndex = groupIndices.find(key); 
+            if (groupIndex == groupIndices.end()) { 
+                groupIndex = groupIndices.emplace(key, noiseGroups_.size()).first; 
+                noiseGroups_.emplace_back(); 
+                noiseGroups_.back().noise = key.first; 
+                noiseGroups_.back().pedestal = key.second; 
+            }
+            noiseGroups_[groupIndex->second].channels.push_back(channelIndex); 
+            channelNoiseGroups_[channelIndex] = groupIndex->second; 
+        }
+    }
+
     void EcalDigiProducer::produce(Event& event) {
 
         TClonesArray* ecalSimHits = (TClonesArray*) event.getCollection(EventConstants::ECAL_SIM_HITS);
@@ -59,22 +180,59 @@ namespace ldmx {
         //          << " ECal hits in event " << event.getEventHeader()->getEventNumber()
         //          << std::endl;
 
+        // Reseed the generators so the noise in this event only depends on 
+        // the base seed, the run and the event number.  These are hashed 
+        // together so that neighbouring events, runs or base seeds don't
+        // share streams, and each generator gets half of the hash.
+        const EventHeader* eventHeader = event.getEventHeader(); 
+        uint64_t eventSeed = splitMix64(splitMix64(splitMix64(randomSeed_) 
+                    ^ uint32_t(eventHeader->getRun())) ^ uint32_t(eventHeader->getEventNumber())); 
+        noiseInjector_->SetSeed(toSeed(eventSeed)); 
+        noiseGenerator_->setSeed(toSeed(eventSeed >> 32)); 
+
+        // Generate the noise for all sim hits in one block
+        noiseGenerator_->generateGaussianNoise(numEcalSimHits, hitNoise_); 
+
+        // Sim hits may share a channel, so track which channels are 
+        // occupied instead of counting hits.
+        occupiedChannels_ = maskedChannels_; 
+        std::vector<int> occupiedInGroup(noiseGroups_.size(), 0); 
+
         //First we simulate noise injection into each hit and store layer-wise 
         // max cell ids
         for (int iHit = 0; iHit < numEcalSimHits; iHit++) {
             
             SimCalorimeterHit* simHit = (SimCalorimeterHit*) ecalSimHits->At(iHit);
 
-            double hitNoise = noiseInjector_->Gaus(0, noiseRMS_);
-            layer_cell_pair hit_pair = hitToPair(simHit);
-
             EcalHit* digiHit = (EcalHit*) (ecalDigis_->ConstructedAt(iHit));
 
-            digiHit->setID(simHit->getID());
-            double energy = simHit->getEdep() + hitNoise;
+            int detIDraw = simHit->getID(); 
+            EcalDetectorID::Fields fields = EcalDetectorID::decode(detIDraw); 
+            int layer = fields.layer; 
+
+            // Check each field, since an out of range module or cell would 
+            // still give a channel index within the ECal, of another channel
+            if (fields.layer >= NUM_ECAL_LAYERS || fields.module >= HEX_MODULES_PER_LAYER 
+                    || fields.cell >= CELLS_PER_HEX_MODULE) { 
+                EXCEPTION_RAISE("EcalDigiProducer", "The sim hit with ID " + std::to_string(detIDraw) 
+                        + " is outside of the ECal readout."); 
+            }
+            int channelIndex = getChannelIndex(layer, fields.module, fields.cell); 
+            if (!occupiedChannels_.test(channelIndex)) { 
+                occupiedChannels_.set(channelIndex); 
+                ++occupiedInGroup[channelNoiseGroups_[channelIndex]]; 
+            }
+
+            digiHit->setID(detIDraw);
+
+            // The noise was generated with the default RMS, so rescale it 
+            // for channels with their own noise
+            const ChannelCondition& condition = conditions_->get(channelIndex); 
+            double noise = condition.noise < 0 ? hitNoise_[iHit] : hitNoise_[iHit]*(condition.noise/noiseRMS_); 
+            double energy = condition.isMasked() ? 0 : simHit->getEdep() + noise + condition.pedestal;
             digiHit->setAmplitude(energy);
             if (energy > readoutThreshold_) {
-                digiHit->setEnergy(((energy/MIP_SI_RESPONSE)*LAYER_WEIGHTS[hit_pair.first]+energy)*0.948);
+                digiHit->setEnergy(energy*condition.gain*LAYER_CALIBRATION[layer]);
                 digiHit->setTime(simHit->getTime());
             } else {
                 digiHit->setEnergy(0);
@@ -82,41 +240,51 @@ namespace ldmx {
             }
         }
 
-        // Given the number of channels without a hit, calculate the expected 
-        // number of noise hits above the readout threshold and randomly 
-        // assign them to Ecal cells
-        int emptyChannels = TOTAL_CELLS - numEcalSimHits;
-        //std::cout << "[ EcalDigiProducer ]: Total number of empty channels: " << emptyChannels << std::endl;
-        std::vector<double> noiseHits = noiseGenerator_->generateNoiseHits(emptyChannels);
-        //std::cout << "[ EcalDigiProducer ]: Total number of noise hits: " << noiseHits.size() << std::endl; 
+        // The noise hits take the subdetector ID of the sim hits, which 
+        // differs between detectors
+        unsigned subdet = numEcalSimHits > 0 ? 
+            EcalDetectorID::SubdetField::decode(((SimCalorimeterHit*) ecalSimHits->At(0))->getID()) 
+            : DEFAULT_ECAL_SUBDET; 
+
+        // For each group of channels with the same noise and pedestal, 
+        // calculate the expected number of noise hits above the readout 
+        // threshold given the number of channels without a hit, and randomly 
+        // assign them to empty channels of the group.  A pedestal shifts the
+        // threshold the noise has to pass.
         int iHit = numEcalSimHits; 
-        for (double noiseHit : noiseHits) { 
-            //std::cout << "[ EcalDigiProducer ]: Noise hit amplitude: " << noiseHit << std::endl;
+        for (std::size_t groupIndex = 0; groupIndex < noiseGroups_.size(); ++groupIndex) { 
+            const NoiseGroup& group = noiseGroups_[groupIndex]; 
+            int emptyChannels = group.channels.size() - occupiedInGroup[groupIndex];
+            noiseGenerator_->setNoise(group.noise); 
+            noiseGenerator_->setNoiseThreshold(readoutThreshold_ - group.pedestal); 
+            std::vector<double> noiseHits = noiseGenerator_->generateNoiseHits(emptyChannels);
+            for (double noiseHit : noiseHits) { 
 
-            // Construct a hit in the ith position
-            EcalHit* digiHit = (EcalHit*) (ecalDigis_->ConstructedAt(iHit));
+                // Pick a random empty channel of the group.  Occupancy is 
+                // low, so rejecting occupied channels rarely needs more than
+                // one draw.
+                int channelIndex = group.channels[noiseInjector_->Integer(group.channels.size())]; 
+                while (occupiedChannels_.test(channelIndex)) { 
+                    channelIndex = group.channels[noiseInjector_->Integer(group.channels.size())]; 
+                }
+                occupiedChannels_.set(channelIndex); 
+                int detIDraw = EcalDetectorID::SubdetField::replace(channelIDs_[channelIndex], subdet); 
+                double amplitude = noiseHit + group.pedestal; 
+
+                // Construct a hit in the ith position
+                EcalHit* digiHit = (EcalHit*) (ecalDigis_->ConstructedAt(iHit));
             
-            // Set the raw energy of the hit
-            digiHit->setAmplitude(noiseHit);
-
-            // Generate a random ID and pack it
-            int layerID = noiseInjector_->Integer(NUM_ECAL_LAYERS); 
-            //std::cout << "[ EcalDigiProducer ]: Random layer ID: " << layerID << std::endl;
-            int moduleID = noiseInjector_->Integer(HEX_MODULES_PER_LAYER); 
-            //std::cout << "[ EcalDigiProducer ]: Random module ID: " << moduleID << std::endl;
-            int cellID = noiseInjector_->Integer(CELLS_PER_HEX_MODULE); 
-            //std::cout << "[ EcalDigiProducer ]: Random cell ID: " << cellID << std::endl;
-            detID_.setFieldValue(1, layerID); 
-            detID_.setFieldValue(2, moduleID); 
-            detID_.setFieldValue(3, cellID); 
-            digiHit->setID(detID_.pack()); 
-
-            // Set the calibrated energy of the hit
-            digiHit->setEnergy(((noiseHit/MIP_SI_RESPONSE)*LAYER_WEIGHTS[layerID]+noiseHit)*0.948);
+                // Set the raw energy of the hit
+                digiHit->setAmplitude(amplitude);
+                digiHit->setID(detIDraw); 
+
+                // Set the calibrated energy of the hit
+                digiHit->setEnergy(amplitude*conditions_->get(channelIndex).gain*LAYER_CALIBRATION[getLayer(detIDraw)]);
             
-            // Identify this hit as a noise hit.
-            digiHit->setNoiseHit(true);
-            ++iHit; 
+                // Identify this hit as a noise hit.
+                digiHit->setNoiseHit(true);
+                ++iHit; 
+            }
         } 
 
         event.add("ecalDigis", ecalDigis_);
@@ -10,11 +10,13 @@
 // LDMX
 #include "Event/EcalHit.h"
 #include "Event/EventConstants.h"
+#include "Event/TruthSummary.h"
 
 // C++
 #include <algorithm>
 #include <stdlib.h>
 #include <fstream>
+#include <iostream>
 #include <cmath>
 
 namespace ldmx {
@@ -78,7 +80,11 @@ namespace ldmx {
 
             BDTHelper_ = new BDTHelper(bdtFileName_);
         }
-        hexReadout_ = new EcalHexReadout();
+        // the hex readout is shared with the other ECal processors, and
+        // replaced by the readout of the run's detector in onNewRun()
+        hexReadoutCache_ = ps.getString("hex_readout_cache", "");
+        hexReadout_ = &EcalHexReadout::getInstance(EcalHexReadout::defaultMinR, EcalHexReadout::defaultGap_, 
+                EcalHexReadout::defaultNCellsWide, hexReadoutCache_);
         nEcalLayers_ = ps.getInteger("num_ecal_layers");
 
         bdtCutVal_ = ps.getDouble("disc_cut");
@@ -89,6 +95,18 @@ namespace ldmx {
         cellMapTightIso_.resize(nEcalLayers_, std::map<int, float>());
     }
 
+    void EcalVetoProcessor::onNewRun(const RunHeader& runHeader) {
+        const EcalHexReadout* hexReadout{nullptr};
+        try {
+            hexReadout = &EcalHexReadout::getInstance(EcalHexReadout::getRunGeometry(runHeader.getDetectorName(),
+                        runHeader.getFloatParameter(EventConstants::ECAL_HEX_RADIUS),
+                        runHeader.getFloatParameter(EventConstants::ECAL_HEX_GAP)), hexReadoutCache_);
+        } catch (const std::invalid_argument& e) {
+            EXCEPTION_RAISE("EcalVetoProcessor", e.what());
+        }
+        hexReadout_ = hexReadout;
+    }
+
     void EcalVetoProcessor::clearProcessor(){
         for (int i = 0; i < nEcalLayers_; i++) {
             cellMap_[i].clear();
@@ -149,10 +167,10 @@ namespace ldmx {
                 ecalLayerTime_[hit_pair.first] += (hit->getEnergy()) * hit->getTime();
                 xMean += getCellCentroidXYPair(hit_pair.second).first * hit->getEnergy();
                 yMean += getCellCentroidXYPair(hit_pair.second).second * hit->getEnergy();
-                avgLayerHit_ += hit->getLayer();
-                wavgLayerHit += hit->getLayer() * hit->getEnergy();
-                if (deepestLayerHit_ < hit->getLayer()) {
-                    deepestLayerHit_ = hit->getLayer();
+                avgLayerHit_ += hit_pair.first;
+                wavgLayerHit += hit_pair.first * hit->getEnergy();
+                if (deepestLayerHit_ < hit_pair.first) {
+                    deepestLayerHit_ = hit_pair.first;
                 }
             }
         }
@@ -186,7 +204,7 @@ namespace ldmx {
             if (hit->getEnergy() > 0) {
                 xStd_ += pow((getCellCentroidXYPair(hit_pair.second).first - xMean), 2) * hit->getEnergy();
                 yStd_ += pow((getCellCentroidXYPair(hit_pair.second).second - yMean), 2) * hit->getEnergy();
-                stdLayerHit_ += pow((hit->getLayer() - wavgLayerHit), 2) * hit->getEnergy();
+                stdLayerHit_ += pow((hit_pair.first - wavgLayerHit), 2) * hit->getEnergy();
             }
         }
         
@@ -221,38 +239,51 @@ namespace ldmx {
         if (event.exists("EcalScoringPlaneHits")) {
             const TClonesArray* ecalSpHits{event.getCollection("EcalScoringPlaneHits")};
 
-            // Loop through all of the sim particles and find the recoil 
-            // electron.
+            // Get the recoil electron from the truth summary, if it was made. 
+            // Otherwise, loop through all of the sim particles and find it.
             const TClonesArray* simParticles{event.getCollection("SimParticles")};
             SimParticle* recoilElectron{nullptr}; 
-            for (int simParticleIndex = 0; simParticleIndex < simParticles->GetEntriesFast();
-                    ++simParticleIndex) { 
-                SimParticle* particle = static_cast<SimParticle*>(simParticles->At(simParticleIndex)); 
-
-                // We only care about the recoil electron
-                if ((particle->getPdgID() == 11) && (particle->getParentCount() == 0)) { 
-                    recoilElectron = particle;
-                    break;
-                } 
+            if (event.exists(EventConstants::TRUTH_SUMMARY)) { 
+                const TruthSummary* truthSummary = static_cast<const TruthSummary*>(
+                        event.getCollection(EventConstants::TRUTH_SUMMARY)->At(0));
+                if (truthSummary->getRecoilElectronIndex() >= 0) { 
+                    recoilElectron = static_cast<SimParticle*>(
+                            simParticles->At(truthSummary->getRecoilElectronIndex())); 
+                }
+            } else { 
+                for (int simParticleIndex = 0; simParticleIndex < simParticles->GetEntriesFast();
+                        ++simParticleIndex) { 
+                    SimParticle* particle = static_cast<SimParticle*>(simParticles->At(simParticleIndex)); 
+
+                    // We only care about the recoil electron
+                    if ((particle->getPdgID() == 11) && (particle->getParentCount() == 0)) { 
+                        recoilElectron = particle;
+                        break;
+                    } 
+                }
             }
 
-            for (int ecalSpIndex = 0; ecalSpIndex < ecalSpHits->GetEntriesFast(); ++ecalSpIndex) {
-                SimTrackerHit* spHit =  static_cast<SimTrackerHit*>(ecalSpHits->At(ecalSpIndex)); 
+            // Without a recoil electron, the comparison below would match 
+            // hits whose particle reference is null.
+            if (recoilElectron) { 
+                for (int ecalSpIndex = 0; ecalSpIndex < ecalSpHits->GetEntriesFast(); ++ecalSpIndex) {
+                    SimTrackerHit* spHit =  static_cast<SimTrackerHit*>(ecalSpHits->At(ecalSpIndex)); 
                 
-                if (spHit->getLayerID() != 1) continue;
+                    if (spHit->getLayerID() != 1) continue;
                 
-                SimParticle* spParticle = spHit->getSimParticle();
-                if (spParticle == recoilElectron) { 
-                    recoilP = spHit->getMomentum();
-                    recoilPos = spHit->getPosition();
-                    if (recoilP[2] <= 0) continue; 
-                    /*std::cout << "[ EcalVetoProcessor ]: " 
-                              << "Recoil momentum: [ " 
-                              << recoilP[0] 
-                              << ", " << recoilP[1]  
-                              << ", " << recoilP[2] << " ]" << std::endl;*/
-                    break;
-                } 
+                    SimParticle* spParticle = spHit->getSimParticle();
+                    if (spParticle == recoilElectron) { 
+                        recoilP = spHit->getMomentum();
+                        recoilPos = spHit->getPosition();
+                        if (recoilP[2] <= 0) continue; 
+                        /*std::cout << "[ EcalVetoProcessor ]: " 
+                                  << "Recoil momentum: [ " 
+                                  << recoilP[0] 
+                                  << ", " << recoilP[1]  
+                                  << ", " << recoilP[2] << " ]" << std::endl;*/
+                        break;
+                    } 
+                }
             }
         }
 
@@ -277,15 +308,9 @@ namespace ldmx {
         event.addToCollection("EcalVeto", result_);
     }
 
-    EcalVetoProcessor::LayerCellPair EcalVetoProcessor::hitToPair(EcalHit* hit) {
-        int detIDraw = hit->getID();
-        detID_.setRawValue(detIDraw);
-        detID_.unpack();
-        int layer = detID_.getFieldValue("layer");
-        int cellid = detID_.getFieldValue("cell");
-        int moduleid = detID_.getFieldValue("module_position");
-        int combinedid = cellid*10+moduleid;
-        return (std::make_pair(layer, combinedid));
+    EcalVetoProcessor::LayerCellPair EcalVetoProcessor::hitToPair(const EcalHit* hit) {
+        EcalDetectorID::Fields fields = EcalDetectorID::decode(hit->getID());
+        return std::make_pair(int(fields.layer), int(fields.cell*10 + fields.module));
     }
 
     /* Function to calculate the energy weighted shower centroid */
@@ -359,10 +384,10 @@ namespace ldmx {
             }
 
             //Skip hits that have a readout neighbor
-            std::vector<int> cellNbrIds = getInnerRingCellIds(hit_pair.second);
+            IDRange cellNbrIds = getInnerRingCellIds(hit_pair.second);
 
             //Get neighboring cell id's and try to look them up in the full cell map (constant speed algo.)
-            for (int k = 0; k < 6; k++) {
+            for (unsigned k = 0; k < cellNbrIds.size(); k++) {
                 std::map<int, float>::iterator it = cellMap_[hit_pair.first].find(cellNbrIds[k]);
                 if (it != cellMap_[hit_pair.first].end()) {
                     isolatedHit = std::make_pair(false, cellNbrIds[k]);
@@ -7,6 +7,12 @@
 
 #include "EventProc/FindableTrackProcessor.h"
 
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <algorithm>
+#include <map>
+
 namespace ldmx { 
 
     FindableTrackProcessor::FindableTrackProcessor(const std::string &name, Process &process) :
@@ -19,6 +25,51 @@ namespace ldmx {
 
     void FindableTrackProcessor::configure(const ParameterSet &pset) { 
    
+        // The tracking strategies, each given by the mask of the recoil 
+        // tracker layers it requires (bit n for layer n + 1).  A strategy 
+        // listed several times can find a particle using any of its masks.
+        // The default strategies require
+        // 4S:   the four stereo modules (layers 1-8)
+        // 3S1A: the first three stereo modules and either axial layer
+        // 2S2A: the first two stereo modules and both axial layers
+        // 2A:   both axial layers (layers 9-10)
+        // 2S:   the first two stereo modules
+        // 3S:   the first three stereo modules
+        std::vector<std::string> names = pset.getVString("strategies", 
+                {"4S", "3S1A", "3S1A", "2S2A", "2A", "2S", "3S"}); 
+        std::vector<int> masks = pset.getVInteger("strategy_layer_masks", 
+                {0xFF, 0x13F, 0x23F, 0x30F, 0x300, 0xF, 0x3F}); 
+
+        if (names.size() != masks.size()) { 
+            EXCEPTION_RAISE("FindableTrackProcessor", 
+                    "The number of strategies and strategy layer masks differ."); 
+        }
+
+        static const std::map<std::string, FindableTrackResult::Strategy> legacyStrategies = { 
+            {"4S", FindableTrackResult::STRATEGY_4S}, 
+            {"3S1A", FindableTrackResult::STRATEGY_3S1A}, 
+            {"2S2A", FindableTrackResult::STRATEGY_2S2A}, 
+            {"2A", FindableTrackResult::STRATEGY_2A}, 
+            {"2S", FindableTrackResult::STRATEGY_2S}, 
+            {"3S", FindableTrackResult::STRATEGY_3S}
+        };
+
+        for (std::size_t iMask = 0; iMask < masks.size(); ++iMask) { 
+            auto name = std::find(strategyNames_.begin(), strategyNames_.end(), names[iMask]); 
+            if (name == strategyNames_.end()) { 
+                if (strategyNames_.size() == MAX_STRATEGIES) { 
+                    EXCEPTION_RAISE("FindableTrackProcessor", 
+                            "At most " + std::to_string(MAX_STRATEGIES) + " strategies are supported."); 
+                }
+                auto legacy = legacyStrategies.find(names[iMask]); 
+                legacyStrategies_.push_back(legacy == legacyStrategies.end() ? 
+                        FindableTrackResult::STRATEGY_NONE : legacy->second); 
+                name = strategyNames_.insert(strategyNames_.end(), names[iMask]); 
+            }
+            requiredLayers_.push_back(masks[iMask]); 
+            strategyBits_.push_back(1u << (name - strategyNames_.begin())); 
+        }
+
         // Instantiate the container that will hold the results
         findableTrackResults_ = new TClonesArray("ldmx::FindableTrackResult", 10000);
     }
@@ -33,142 +84,105 @@ namespace ldmx {
         // const TClonesArray *recoilSimHits = event.getCollection("RecoilSimHits");  
         const TClonesArray *siStripHits = event.getCollection("SiStripHits");  
 
-        // Create the hit map
-        //this->createHitMap(recoilSimHits); 
+        // Map the sim particles to dense indices and count their hits
+        this->indexParticles(simParticles); 
         this->createHitMap(siStripHits); 
         
         // Loop through all sim particles and check which are findable 
         int resultCount = 0;
         for (int particleCount = 0; particleCount < simParticles->GetEntriesFast(); ++particleCount) { 
             
+            // Skip particles without hits in the recoil tracker
+            if (layerMasks_[particleCount] == 0) continue;
+
             // Get the ith particle from the collection of sim particles
             SimParticle* simParticle = static_cast<SimParticle*>(simParticles->At(particleCount));
 
             // If the sim particle is neutral, skip it.
             if (abs(simParticle->getCharge()) != 1) continue;
     
-            // Check if the track is findable 
-            if (hitMap_.count(simParticle) == 1) {
+            // Create a result instance
+            FindableTrackResult* findableTrackResult 
+                = (FindableTrackResult*) findableTrackResults_->ConstructedAt(resultCount);
                 
-                // Create a result instance
-                FindableTrackResult* findableTrackResult 
-                    = (FindableTrackResult*) findableTrackResults_->ConstructedAt(resultCount);
-                
-                // Set the sim particle associated with the result
-                findableTrackResult->setSimParticle(simParticle);
+            // Set the sim particle associated with the result
+            findableTrackResult->setSimParticle(simParticle);
 
-                // Check if the track is findable
-                this->isFindable(findableTrackResult, hitMap_[simParticle]); 
-                resultCount++;
-            }      
+            // Check if the track is findable
+            this->isFindable(findableTrackResult, layerMasks_[particleCount]); 
+            resultCount++;
         }
 
         //Add the result to the collection
         event.add("FindableTracks", findableTrackResults_);
     }
 
+    void FindableTrackProcessor::indexParticles(const TClonesArray* simParticles) { 
+
+        int nParticles = simParticles->GetEntriesFast(); 
+
+        particleIndices_.clear();
+        for (int index = 0; index < nParticles; ++index) { 
+            particleIndices_.emplace_back(static_cast<const SimParticle*>(simParticles->At(index)), index);
+        }
+        std::sort(particleIndices_.begin(), particleIndices_.end()); 
+
+        layerMasks_.assign(nParticles, 0);
+    }
+
+    int FindableTrackProcessor::getParticleIndex(const SimParticle* simParticle) const { 
+        auto it = std::lower_bound(particleIndices_.begin(), particleIndices_.end(), 
+                std::make_pair(simParticle, -1)); 
+        if (it == particleIndices_.end() || it->first != simParticle) return -1; 
+        return it->second;
+    }
+
     void FindableTrackProcessor::createHitMap(const TClonesArray* siStripHits) { 
        
-        // Clear the hit map to remove any previous relations 
-        hitMap_.clear();
-
-        // Loop over all recoil tracker sim hits and check which layers, if any,
+        // Loop over all recoil tracker hits and check which layers, if any,
         // the sim particle deposited energy in.
-        std::vector<int> recoilHitCount(10, 0);
+        const SimParticle* lastParticle{nullptr};
+        int particleIndex{-1};
         for (int hitCount = 0; hitCount < siStripHits->GetEntriesFast(); ++hitCount) {
 
-            // Get the SimTrackerHit from the collection of recoil sim hits.
-            //SimTrackerHit* recoilSimHit 
-            //    = static_cast<SimTrackerHit*>(recoilSimHits->At(hitCount));
             SiStripHit* siStripHit 
                 = static_cast<SiStripHit*>(siStripHits->At(hitCount));
            
             // Get the SimTrackerHit associated with this strip hit
             SimTrackerHit* simTrackerHit = static_cast<SimTrackerHit*>(siStripHit->getSimTrackerHits()->At(0));  
 
-            // Get the MC particle associated with this hit
-            SimParticle* simParticle = simTrackerHit->getSimParticle();
-
-            // If the particle ins't in the hit map, add it.
-            if (hitMap_.count(simParticle) == 0) {
-                hitMap_[simParticle] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+            // Get the MC particle associated with this hit.  Consecutive hits
+            // usually belong to the same particle, so only search on a change.
+            const SimParticle* simParticle = simTrackerHit->getSimParticle();
+            if (simParticle != lastParticle) { 
+                lastParticle = simParticle;
+                particleIndex = getParticleIndex(simParticle); 
             }
+            if (particleIndex < 0) continue;
             
-            // Increment the hit count for the layer
-            hitMap_[simParticle][simTrackerHit->getLayerID() - 1]++;
+            // Mark the layer as hit by the particle
+            int layer = simTrackerHit->getLayerID() - 1;
+            if (layer < 0 || layer >= N_RECOIL_LAYERS) continue;
+            layerMasks_[particleIndex] |= 1u << layer;
         }
     }
 
-    void FindableTrackProcessor::isFindable(FindableTrackResult* result, std::vector<int> hitCount) { 
+    void FindableTrackProcessor::isFindable(FindableTrackResult* result, unsigned layerMask) { 
        
-        /*std::cout << "[ FindableTrackProcessor ]: Hit Vec [ ";
-        for (auto index : hitCount) { 
-            std::cout << index << ", ";
-        }
-        std::cout << " ]" << std::endl;*/
-
-        // Count how many 3D stereo hits are created by this particle
-        std::vector<int> hit3dVec{0, 0, 0, 0};
-        int hit3dCount{0};
-        for (int layerN = 0; layerN  < 8; layerN += 2) { 
-            if (hitCount[layerN]*hitCount[layerN+1] != 0) {
-                hit3dCount++;
-                hit3dVec[layerN/2]++; 
-            }
-        }
-        /*std::cout << "[ FindableTrackProcessor ]: " 
-                  << "Total 3D Hits: " << hit3dCount << std::endl;*/
-         
-
-        // A track is considered findable if 
-        // 1) The first four stereo layers are hit
-        // 2) Three of the first four layers are hit and an axial layer is hit
-        // 3) Two of the first four layers are hit and both axial layers are hit
-        bool trackFound{false};
-        if (hit3dCount == 4) { 
-            result->setResult(FindableTrackResult::STRATEGY_4S, true); 
-            trackFound = true;
-            /*std::cout << "[ FindableTrackProcessor ]: " 
-                      << "Can be found using 4S strategy." << std::endl;*/
-        } 
-        
-        if ((hit3dVec[0]*hit3dVec[1]*hit3dVec[2] > 0) && (hitCount[8] > 0 || hitCount[9] > 0)) {
-            result->setResult(FindableTrackResult::STRATEGY_3S1A, true); 
-            trackFound = true;
-            /*std::cout << "[ findabletrackprocessor ]: " 
-                      << "can be found using 3s1a strategy." << std::endl;*/
-        } 
-        
-        if (hit3dVec[0]*hit3dVec[1] > 0 && (hitCount[8] > 0 && hitCount[9] > 0)) {
-            result->setResult(FindableTrackResult::STRATEGY_2S2A, true); 
-            trackFound = true;
-            /*std::cout << "[ findabletrackprocessor ]: " 
-                      << "can be found using 2s2a strategy." << std::endl;*/
-        } 
-        
-        if (hitCount[8] > 0 && hitCount[9] > 0) { 
-            result->setResult(FindableTrackResult::STRATEGY_2A, true); 
-            trackFound = true;
-            /*std::cout << "[ findabletrackprocessor ]: " 
-                      << "can be found using 2a strategy." << std::endl;*/
+        unsigned findableMask{0};
+        for (std::size_t iMask = 0; iMask < requiredLayers_.size(); ++iMask) { 
+            if ((layerMask & requiredLayers_[iMask]) == requiredLayers_[iMask]) 
+                findableMask |= strategyBits_[iMask]; 
         }
+        result->setFindableMask(findableMask); 
 
-        if (hit3dVec[0]*hit3dVec[1] > 0) {
-            result->setResult(FindableTrackResult::STRATEGY_2S, true); 
-            trackFound = true;
-            /*std::cout << "[ findabletrackprocessor ]: " 
-                      << "can be found using 2s strategy." << std::endl;*/
-        } 
-
-        if (hit3dVec[0]*hit3dVec[1]*hit3dVec[2] > 0) {
-            result->setResult(FindableTrackResult::STRATEGY_3S, true); 
-            trackFound = true;
-            /*std::cout << "[ findabletrackprocessor ]: " 
-                      << "can be found using 3s strategy." << std::endl;*/
-        } 
-
-        if (!trackFound) { 
+        if (findableMask == 0) { 
             result->setResult(FindableTrackResult::STRATEGY_NONE, false);    
+            return;
+        }
+
+        for (std::size_t strategy = 0; strategy < legacyStrategies_.size(); ++strategy) { 
+            if (findableMask & (1u << strategy)) result->setResult(legacyStrategies_[strategy], true);
         }
     }
 }
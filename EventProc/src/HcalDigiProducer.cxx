@@ -9,6 +9,8 @@
 #include "Event/HcalHit.h"
 #include "EventProc/HcalDigiProducer.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 #include "DetDescr/HcalID.h"
@@ -22,99 +24,164 @@ namespace ldmx {
     }
 
     void HcalDigiProducer::configure(const ParameterSet& ps) {
-        detID_       = new HcalID();
         random_      = new TRandom(ps.getInteger("randomSeed", 1000));
         meanNoise_   = ps.getDouble("meanNoise");
         mev_per_mip_ = ps.getDouble("mev_per_mip");
         pe_per_mip_  = ps.getDouble("pe_per_mip");
         doStrip_     = ps.getInteger("doStrip");
+        conditions_  = &ChannelConditions::getInstance(ps.getString("conditions_file", ""));
+
+        stripLength_[BACK_STRIP] = ps.getDouble("back_strip_length", stripLength_[BACK_STRIP]);
+        stripLength_[SIDE_STRIP] = ps.getDouble("side_strip_length", stripLength_[SIDE_STRIP]);
+        stripCenter_[SIDE_STRIP] = ps.getDouble("side_strip_center_z", stripCenter_[SIDE_STRIP]);
+        nPositionBins_           = ps.getInteger("strip_position_bins", nPositionBins_);
+        attenuationLength_       = ps.getDouble("attenuation_length", attenuationLength_);
+        lightVelocity_           = ps.getDouble("light_velocity", lightVelocity_);
+        timeResolution_          = ps.getDouble("time_resolution", timeResolution_);
+
+        if (nPositionBins_ < 1) {
+            EXCEPTION_RAISE("HcalDigiProducer", "The number of strip position bins must be positive.");
+        }
+
+        buildReadoutTables();
+    }
+
+    void HcalDigiProducer::buildReadoutTables() {
+
+        peYield_.resize(N_STRIP_TYPES*nPositionBins_*2);
+        propagationTime_.resize(N_STRIP_TYPES*nPositionBins_*2);
+
+        for (int type = 0; type < N_STRIP_TYPES; type++) {
+            double length = stripLength_[type];
+
+            // normalize the yield so that a MIP at the center of the strip 
+            // gives pe_per_mip summed over both ends
+            double centerYield = 0.5 * pe_per_mip_ / mev_per_mip_ / exp(-0.5*length/attenuationLength_);
+
+            for (int bin = 0; bin < nPositionBins_; bin++) {
+                // distance from the center of the bin to the negative end
+                double distance = (bin + 0.5) * length / nPositionBins_;
+                int index = (type*nPositionBins_ + bin)*2;
+
+                peYield_[index]     = centerYield * exp(-distance/attenuationLength_);
+                peYield_[index + 1] = centerYield * exp(-(length - distance)/attenuationLength_);
+
+                propagationTime_[index]     = distance / lightVelocity_;
+                propagationTime_[index + 1] = (length - distance) / lightVelocity_;
+            }
+        }
+    }
+
+    int HcalDigiProducer::getTableIndex(int stripType, float pos) const {
+        int bin = int((pos/stripLength_[stripType] + 0.5) * nPositionBins_);
+        if (bin < 0) bin = 0;
+        else if (bin >= nPositionBins_) bin = nPositionBins_ - 1;
+        return (stripType*nPositionBins_ + bin)*2;
     }
 
     void HcalDigiProducer::produce(Event& event) {
 
-        std::map<int, int>   hcalLayerPEs;
-        std::map<int, float> hcalXpos,hcalYpos,hcalZpos,hcaldetIDEdep, hcaldetIDTime;
+        // reset the channel sums of the previous event
+        clearChannels();
 
         // looper over sim hits and aggregate energy depositions for each detID
         TClonesArray* hcalHits = (TClonesArray*) event.getCollection(EventConstants::HCAL_SIM_HITS, "sim");
 
         int numHCalSimHits = hcalHits->GetEntries();
+
         for (int iHit = 0; iHit < numHCalSimHits; iHit++) {
             SimCalorimeterHit* simHit = (SimCalorimeterHit*) hcalHits->At(iHit);
             int detIDraw = simHit->getID();
-            std::vector<float> position = simHit->getPosition();
-	    
-	    //if we aggregate by layer, set all strip to zero and rcalculate the detIDraw
-	    if (doStrip_ == 0){
-                detID_->setRawValue(detIDraw);
-	        detID_->unpack();
-	        detID_->setFieldValue(3,0);
-                detIDraw = detID_->pack();
-	    }           
+
+            //if we aggregate by layer, set all strip to zero and rcalculate the detIDraw
+            if (doStrip_ == 0) {
+                detIDraw = HcalID::StripField::replace(detIDraw, 0);
+            }
 
             if (verbose_) {
                 std::cout << "detIDraw: " << detIDraw << std::endl;
-                detID_->setRawValue(detIDraw);
-                detID_->unpack();
-                int layer = detID_->getFieldValue("layer");
-                int subsection = detID_->getFieldValue("section");
-                int strip = detID_->getFieldValue("strip");                
-                std::cout << "section: " << subsection << "  layer: " << layer <<  "  strip: " << strip <<std::endl;
+                HcalID::Fields fields = HcalID::decode(detIDraw);
+                std::cout << "section: " << fields.section << "  layer: " << fields.layer <<  "  strip: " << fields.strip <<std::endl;
             }           
             
-	    // for now, we take am energy weighted average of the hit in each stip to simulate the hit position. 
-            // will use strip TOF and light yield between strips to estimate position.            
-	    if (hcaldetIDEdep.find(detIDraw) == hcaldetIDEdep.end()) {
-                // first hit, initialize
-                hcaldetIDEdep[detIDraw] = simHit->getEdep();
-                hcaldetIDTime[detIDraw] = simHit->getTime() * simHit->getEdep();
-                hcalXpos[detIDraw]      = position[0]* simHit->getEdep();
-                hcalYpos[detIDraw]      = position[1]* simHit->getEdep();
-                hcalZpos[detIDraw]      = position[2]* simHit->getEdep();
-            } else {
-                // not first hit, aggregate, and store the largest radius hit
-                hcalXpos[detIDraw]      += position[0]* simHit->getEdep();
-                hcalYpos[detIDraw]      += position[1]* simHit->getEdep();
-                hcalZpos[detIDraw]      += position[2]* simHit->getEdep();
-                hcaldetIDEdep[detIDraw] += simHit->getEdep();
-                hcaldetIDTime[detIDraw] += simHit->getTime() * simHit->getEdep();
-            
-	    }
-	    
+            // the light of each deposition is attenuated on its way to both 
+            // ends of the strip, and the discriminator at each end fires on 
+            // the first light to arrive
+            int stripType = getSectionStripType(HcalID::SectionField::decode(detIDraw));
+            float pos = (stripType == BACK_STRIP ? simHit->getX() : simHit->getZ()) - stripCenter_[stripType];
+            int index = getTableIndex(stripType, pos);
+
+            float edep = simHit->getEdep();
+            float time = simHit->getTime();
+            ChannelSums& sums = getChannelSums(detIDraw);
+            sums.edep += edep;
+            sums.time += time * edep;
+            sums.x    += simHit->getX() * edep;
+            sums.y    += simHit->getY() * edep;
+            sums.z    += simHit->getZ() * edep;
+            for (int end = 0; end < 2; end++) {
+                sums.meanPE[end] += edep * peYield_[index + end];
+                sums.arrival[end] = std::min(sums.arrival[end], time + propagationTime_[index + end]);
+            }
         } 
 
+        // emit the hits in order of detID, as they were when the sums were 
+        // kept in std::maps
+        std::sort(channels_.begin(), channels_.end(), 
+                [](const ChannelSums& a, const ChannelSums& b) { return a.detID < b.detID; });
 
         // loop over detIDs and simulate number of PEs
         int ihit = 0;
-        for (std::map<int, float>::iterator it = hcaldetIDEdep.begin(); it != hcaldetIDEdep.end(); ++it) {
-            int detIDraw = it->first;
-            double depEnergy = hcaldetIDEdep[detIDraw];
-            hcaldetIDTime[detIDraw] = hcaldetIDTime[detIDraw] / hcaldetIDEdep[detIDraw];
-            hcalXpos[detIDraw]      = hcalXpos[detIDraw] / hcaldetIDEdep[detIDraw];
-            hcalYpos[detIDraw]      = hcalYpos[detIDraw] / hcaldetIDEdep[detIDraw];
-            hcalZpos[detIDraw]      = hcalZpos[detIDraw] / hcaldetIDEdep[detIDraw];
-            double meanPE           = depEnergy / mev_per_mip_ * pe_per_mip_;
-
-            //std::default_random_engine generator;
-            //std::poisson_distribution<int> distribution(meanPE);
-            hcalLayerPEs[detIDraw] = random_->Poisson(meanPE);
-            hcalLayerPEs[detIDraw] += random_->Gaus(meanNoise_);
+        for (const ChannelSums& sums : channels_) {
+            int detIDraw = sums.detID;
+
+            // channels get their own gain, pedestal and noise RMS if there 
+            // are conditions for them
+            const ChannelCondition& condition = conditions_->get(getChannelIndex(detIDraw));
+            double depEnergy = sums.edep;
+            float time = sums.time / sums.edep;
+            float xpos = sums.x / sums.edep;
+            float ypos = sums.y / sums.edep;
+            float zpos = sums.z / sums.edep;
+
+            int endPE[2];
+            float endTime[2];
+            for (int end = 0; end < 2; end++) {
+                endPE[end] = random_->Poisson(sums.meanPE[end] * condition.gain);
+                endTime[end] = sums.arrival[end];
+                if (timeResolution_ > 0) endTime[end] += random_->Gaus(0, timeResolution_);
+            }
+            int nPE = endPE[0] + endPE[1];
+            nPE += (condition.noise < 0 ? random_->Gaus(meanNoise_) : random_->Gaus(meanNoise_, condition.noise)) + condition.pedestal;
+
+            // dead and hot channels are dropped only after their random 
+            // numbers are drawn, so masking a channel doesn't change the 
+            // response of the others
+            if (condition.isMasked()) continue;
+
+            // with light seen at both ends, the time difference gives the 
+            // position along the strip and the mean time is independent of it
+            if (endPE[0] > 0 && endPE[1] > 0) {
+                int stripType = getStripType(detIDraw);
+                double halfLength = 0.5*stripLength_[stripType];
+                double pos = 0.5*(endTime[0] - endTime[1])*lightVelocity_;
+                pos = std::max(-halfLength, std::min(halfLength, pos)) + stripCenter_[stripType];
+                if (stripType == BACK_STRIP) xpos = pos;
+                else zpos = pos;
+                time = 0.5*(endTime[0] + endTime[1]) - halfLength/lightVelocity_;
+            }
 
             if (verbose_) {
-                detID_->setRawValue(detIDraw);
-                detID_->unpack();
-                int layer = detID_->getFieldValue("layer");
-                int subsection = detID_->getFieldValue("section");
-                int strip = detID_->getFieldValue("strip");
+                HcalID::Fields fields = HcalID::decode(detIDraw);
 
                 std::cout << "detID: " << detIDraw << std::endl;
-                std::cout << "Layer: " << layer << std::endl;
-                std::cout << "Subsection: " << subsection << std::endl;
-                std::cout << "Strip: " << strip << std::endl;
-                std::cout << "Edep: " << hcaldetIDEdep[detIDraw] << std::endl;
-                std::cout << "numPEs: " << hcalLayerPEs[detIDraw] << std::endl;
-                std::cout << "time: " << hcaldetIDTime[detIDraw] << std::endl;
-                std::cout << "z: " << hcalZpos[detIDraw] << std::endl;
+                std::cout << "Layer: " << fields.layer << std::endl;
+                std::cout << "Subsection: " << fields.section << std::endl;
+                std::cout << "Strip: " << fields.strip << std::endl;
+                std::cout << "Edep: " << depEnergy << std::endl;
+                std::cout << "numPEs: " << nPE << std::endl;
+                std::cout << "time: " << time << std::endl;
+                std::cout << "z: " << zpos << std::endl;
             }        // end verbose
 
 	    // need to add in a weighting factor eventually, so keep it that way to make sure
@@ -124,13 +191,13 @@ namespace ldmx {
             HcalHit *hit = (HcalHit*) (hits_->ConstructedAt(ihit));
 
             hit->setID(detIDraw);
-            hit->setPE(hcalLayerPEs[detIDraw]);
-            hit->setAmplitude(hcalLayerPEs[detIDraw]);
+            hit->setPE(nPE);
+            hit->setAmplitude(nPE);
             hit->setEnergy(energy);
-            hit->setTime(hcaldetIDTime[detIDraw]);
-            hit->setXpos(hcalXpos[detIDraw]);
-            hit->setYpos(hcalYpos[detIDraw]);
-            hit->setZpos(hcalZpos[detIDraw]);
+            hit->setTime(time);
+            hit->setXpos(xpos);
+            hit->setYpos(ypos);
+            hit->setZpos(zpos);
             ihit++;
         } 
         
@@ -138,6 +205,48 @@ namespace ldmx {
         event.add("hcalDigis", hits_);
     }
 
+    HcalDigiProducer::ChannelSums& HcalDigiProducer::getChannelSums(int detIDraw) {
+
+        // keep the table at most half full so probe sequences stay short
+        if (2*(channels_.size() + 1) > channelTable_.size()) growChannelTable(); 
+
+        unsigned mask = channelTable_.size() - 1;
+        unsigned slot = hashChannel(detIDraw);
+        while (channelTable_[slot] != -1) {
+            ChannelSums& sums = channels_[channelTable_[slot]];
+            if (sums.detID == detIDraw) return sums;
+            slot = (slot + 1) & mask;
+        }
+
+        // first hit in this channel
+        channelTable_[slot] = channels_.size();
+        usedSlots_.push_back(slot);
+        channels_.push_back(ChannelSums());
+        channels_.back().detID = detIDraw;
+        return channels_.back();
+    }
+
+    void HcalDigiProducer::clearChannels() {
+        for (unsigned slot : usedSlots_) channelTable_[slot] = -1;
+        usedSlots_.clear();
+        channels_.clear();
+    }
+
+    void HcalDigiProducer::growChannelTable() {
+
+        if (!channelTable_.empty()) ++tableBits_;
+        channelTable_.assign(1u << tableBits_, -1);
+        usedSlots_.clear();
+
+        unsigned mask = channelTable_.size() - 1;
+        for (std::size_t index = 0; index < channels_.size(); ++index) {
+            unsigned slot = hashChannel(channels_[index].detID);
+            while (channelTable_[slot] != -1) slot = (slot + 1) & mask;
+            channelTable_[slot] = index;
+            usedSlots_.push_back(slot);
+        }
+    }
+
 }
 
 DECLARE_PRODUCER_NS(ldmx, HcalDigiProducer);
@@ -6,6 +6,11 @@
 
 #include "EventProc/HcalVetoProcessor.h"
 
+//----------//
+//   LDMX   //
+//----------//
+#include "DetDescr/HcalID.h"
+
 namespace ldmx {
 
     HcalVetoProcessor::HcalVetoProcessor(const std::string &name, Process &process) : 
@@ -17,6 +22,15 @@ namespace ldmx {
 
     void HcalVetoProcessor::configure(const ParameterSet& pSet) {
         totalPEThreshold_  = pSet.getDouble("pe_threshold"); 
+
+        // The digis can have negative PEs from noise, so a single section or 
+        // hit can exceed the total.  These criteria are therefore disabled 
+        // unless they are configured.
+        backPEThreshold_ = pSet.getDouble("back_pe_threshold", backPEThreshold_); 
+        sidePEThreshold_ = pSet.getDouble("side_pe_threshold", sidePEThreshold_); 
+        maxPEThreshold_  = pSet.getDouble("max_pe_threshold", maxPEThreshold_); 
+        minTime_ = pSet.getDouble("min_time", minTime_); 
+        maxTime_ = pSet.getDouble("max_time", maxTime_); 
     }
 
     void HcalVetoProcessor::produce(Event& event) {
@@ -25,22 +39,38 @@ namespace ldmx {
         const TClonesArray *hcalHits = event.getCollection("hcalDigis");
         //if (hcalHits->GetEntriesFast() == 0) return; 
        
-        // Loop over all of the Hcal hits and calculate to total photoelectrons
-        // in the event.
-        float totalPe{0};
+        // Loop over all of the Hcal hits and sum the photoelectrons of the
+        // hits in the time window per section.
+        float backPE{0};
+        float sidePE{0};
         float maxPE{0}; 
+        int maxPEHitID{0};
+        float outOfTimePE{0};
         for (int iHit = 0; iHit < hcalHits->GetEntriesFast(); ++iHit) { 
             HcalHit* hcalHit = (HcalHit*) hcalHits->At(iHit);
-            //std::cout << "[ HcalVeto ]: Hit PE: " << hcalHit->getPE() << std::endl;
-            totalPe += hcalHit->getPE(); 
-            maxPE = std::max(maxPE,hcalHit->getPE());
+            float pe = hcalHit->getPE();
+
+            if (hcalHit->getTime() < minTime_ || hcalHit->getTime() > maxTime_) { 
+                outOfTimePE += pe;
+                continue;
+            }
+
+            if (hcalHit->getSection() == HcalSection::BACK) backPE += pe; 
+            else sidePE += pe;
+
+            if (pe > maxPE) { 
+                maxPE = pe;
+                maxPEHitID = hcalHit->getID(); 
+            }
         }
 
         bool passesVeto{true}; 
-        //std::cout << "[ HcalVeto ]: total PE: " << totalPe << std::endl;
-        if (totalPe >= totalPEThreshold_) passesVeto = false;
-        //if (maxPE >= totalPEThreshold_) passesVeto = false;
+        if (backPE + sidePE >= totalPEThreshold_) passesVeto = false;
+        if (backPE >= backPEThreshold_) passesVeto = false;
+        if (sidePE >= sidePEThreshold_) passesVeto = false;
+        if (maxPE >= maxPEThreshold_) passesVeto = false;
         
+        result_.setPESums(backPE, sidePE, maxPE, outOfTimePE, maxPEHitID); 
         result_.setResult(passesVeto); 
         event.addToCollection("HcalVeto", result_);
     }
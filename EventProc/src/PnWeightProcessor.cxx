@@ -28,14 +28,6 @@ namespace ldmx {
 
     PnWeightProcessor::PnWeightProcessor(const std::string &name, Process &process) :
         Producer(name, process) {
-
-            lFit->SetParameters(0.01093, 2.766); 
-
-            std::string func = "exp([1]-[0]*x)*([2]+[3]*x + [4]*pow(x,2)"; 
-            func += " + [5]*pow(x,3) + [6]*pow(x,4) + [7]*pow(x,5) + [8]*pow(x,6))"; 
-            hFit = new TF1("hfit", func.c_str(), 1150, 3700);
-            hFit->SetParameters(0.004008, 11.23, 1.242e-6, -1.964e-9, 
-                    8.243e-13, 9.333e-17, -7.584e-20, -1.991e-23, 9.757e-27);
     }
 
     PnWeightProcessor::~PnWeightProcessor() { 
@@ -44,6 +36,25 @@ namespace ldmx {
     void PnWeightProcessor::configure(const ParameterSet& pSet) {
         wThreshold_ = pSet.getDouble("w_threshold");
         thetaThreshold_ = pSet.getDouble("theta_threshold");
+
+        // Fit to the lower slope of the inclusive W (theta > 100) plot, 
+        // exp([1] - [0]*W)
+        std::vector<double> lFitParams = pSet.getVDouble("lfit_parameters", {0.01093, 2.766}); 
+
+        // Fit to the high tail of the inclusive W (theta > 100) plot, 
+        // exp([1] - [0]*W)*([2] + [3]*W + [4]*W^2 + ...)
+        std::vector<double> hFitParams = pSet.getVDouble("hfit_parameters", 
+                {0.004008, 11.23, 1.242e-6, -1.964e-9, 8.243e-13, 9.333e-17, -7.584e-20, -1.991e-23, 9.757e-27}); 
+
+        if (lFitParams.size() != 2 || hFitParams.size() < 3) { 
+            EXCEPTION_RAISE("PnWeightProcessor", 
+                    "lfit_parameters needs 2 values and hfit_parameters at least 3."); 
+        }
+
+        // The ratio of the exponentials of both fits is a single exponential
+        expSlope_ = lFitParams[0] - hFitParams[0];
+        expIntercept_ = lFitParams[1] - hFitParams[1];
+        hFitPolynomial_.assign(hFitParams.begin() + 2, hFitParams.end()); 
     }
 
     void PnWeightProcessor::produce(Event& event) {
@@ -56,39 +67,35 @@ namespace ldmx {
         const TClonesArray* simParticles = event.getCollection("SimParticles");
         if (simParticles->GetEntriesFast() == 0) return; 
 
-        // Loop through all of the particles and search for the recoil electron
-        // i.e. an electron which doesn't have any parents.
-        SimParticle* recoilElectron{nullptr};
-        for (int particleCount = 0; particleCount < simParticles->GetEntriesFast(); ++particleCount) { 
-            
-            // Get the nth particle from the collection of particles
-            SimParticle* simParticle = static_cast<SimParticle*>(simParticles->At(particleCount));
-
-            // If the particle doesn't correspond to the recoil electron, 
-            // continue to the next particle.
-            if ((simParticle->getPdgID() == 11) && (simParticle->getParentCount() == 0)) {
-                //std::cout << "[ pnWeightProcessor ]: Recoil electron found." << std::endl;
-                recoilElectron = simParticle; 
-                break;
+        // Get the PN gamma from the truth summary, if it was made. 
+        // Otherwise, find the recoil electron and search its daughters for
+        // the gamma that underwent a PN reaction.
+        SimParticle* pnGamma{nullptr};
+        if (event.exists(EventConstants::TRUTH_SUMMARY)) { 
+            const TruthSummary* truthSummary = static_cast<const TruthSummary*>(
+                    event.getCollection(EventConstants::TRUTH_SUMMARY)->At(0));
+            if (truthSummary->getPnGammaIndex() >= 0) { 
+                pnGamma = static_cast<SimParticle*>(simParticles->At(truthSummary->getPnGammaIndex()));
+            }
+        } else { 
+            SimParticle* recoilElectron{nullptr};
+            for (int particleCount = 0; particleCount < simParticles->GetEntriesFast(); ++particleCount) { 
+                SimParticle* simParticle = static_cast<SimParticle*>(simParticles->At(particleCount));
+                if ((simParticle->getPdgID() == 11) && (simParticle->getParentCount() == 0)) {
+                    recoilElectron = simParticle; 
+                    break;
+                }
             }
-        }
-        /*std::cout << "[ PnWeightProcessor ]: Recoil electron total daughters: " 
-                  << recoilElectron->getDaughterCount() 
-                  << std::endl;*/
 
-        // Search for the PN gamma and use it to get the PN daughters.
-        SimParticle* pnGamma{nullptr};
-        for (int daughterCount = 0; daughterCount < recoilElectron->getDaughterCount(); ++daughterCount) {
-            SimParticle* daughter = recoilElectron->getDaughter(daughterCount);
-            /*std::cout << "[ PnWeightProcessor ]: Total daughters: "
-                      << daughter->getDaughterCount() 
-                      << std::endl;*/
-            if ((daughter->getDaughterCount() > 0) && 
-                    (daughter->getDaughter(0)->getProcessType() == SimParticle::ProcessType::photonNuclear)) {
-                /*std::cout << "[ PnWeightProcessor ]: Found PN gamma!"
-                          << std::endl;*/
-                pnGamma = daughter; 
-                break;
+            if (recoilElectron) { 
+                for (int daughterCount = 0; daughterCount < recoilElectron->getDaughterCount(); ++daughterCount) {
+                    SimParticle* daughter = recoilElectron->getDaughter(daughterCount);
+                    if ((daughter->getDaughterCount() > 0) && 
+                            (daughter->getDaughter(0)->getProcessType() == SimParticle::ProcessType::photonNuclear)) {
+                        pnGamma = daughter; 
+                        break;
+                    }
+                }
             }
         }
 
@@ -109,26 +116,26 @@ namespace ldmx {
             // Get a daughter of the PN gamma 
             SimParticle* pnDaughter = pnGamma->getDaughter(pnDaughterCount);
 
-            // Calculate the kinetic energy
-            double ke = (pnDaughter->getEnergy() - pnDaughter->getMass());
-
-            // Calculate the momentum
-            double px = pnDaughter->getMomentum()[0];
-            double py = pnDaughter->getMomentum()[1];
-            double pz = pnDaughter->getMomentum()[2];
-            double p = sqrt(px*px + py*py + pz*pz); 
-
-            // Calculate the polar angle
-            double theta = acos(pz/p)*180.0/3.14159;
-
             // Get the PDG ID of the daughter
             long int pdgID = std::abs(pnDaughter->getPdgID());
 
-            double w = this->calculateW(pnDaughter); 
-
             // Check if the daughter particle is a proton or neutron
             if ((pdgID == PROTON_PDGID) || (pdgID == NEUTRON_PDGID)) { 
 
+                // Calculate the kinetic energy
+                double ke = (pnDaughter->getEnergy() - pnDaughter->getMass());
+
+                // Calculate the momentum
+                double px = pnDaughter->getPx();
+                double py = pnDaughter->getPy();
+                double pz = pnDaughter->getPz();
+                double p = sqrt(px*px + py*py + pz*pz); 
+
+                // Calculate the polar angle
+                double theta = acos(pz/p)*180.0/3.14159;
+
+                double w = this->calculateW(p, pz, ke); 
+
                 // Add the W of the current nucleon to the inclusive collection.
                 result_.addW(w);
                 
@@ -172,17 +179,24 @@ namespace ldmx {
     }
 
     double PnWeightProcessor::calculateWeight(double w) {
-        return lFit->Eval(w)/hFit->Eval(w); 
+
+        // Evaluate the polynomial using Horner's method
+        double polynomial{0};
+        for (auto coefficient = hFitPolynomial_.rbegin(); coefficient != hFitPolynomial_.rend(); ++coefficient) {
+            polynomial = polynomial*w + *coefficient; 
+        }
+
+        return exp(expIntercept_ - expSlope_*w)/polynomial; 
     }
 
     double PnWeightProcessor::calculateW(SimParticle* particle, double delta) {
-        double px = particle->getMomentum()[0];
-        double py = particle->getMomentum()[1];
-        double pz = particle->getMomentum()[2];
+        double px = particle->getPx();
+        double py = particle->getPy();
+        double pz = particle->getPz();
         double p = sqrt(px*px + py*py + pz*pz); 
         double ke = particle->getEnergy() - particle->getMass();
 
-        return 0.5*(p + ke)*(sqrt(1 + (delta*delta)) - delta*(pz/p));
+        return calculateW(p, pz, ke, delta);
     }
 }
 
@@ -25,48 +25,42 @@ namespace ldmx {
         const TClonesArray *simParticles = event.getCollection("SimParticles");
         if (simParticles->GetEntriesFast() == 0) return; 
 
-        // Loop through all of the particles and search for the recoil electron
-        // i.e. an electron which doesn't have any parents.
-        SimParticle* recoilElectron{nullptr};
-        for (int particleCount = 0; particleCount < simParticles->GetEntriesFast(); ++particleCount) { 
-            
-            // Get the nth particle from the collection of particles
-            SimParticle* simParticle = static_cast<SimParticle*>(simParticles->At(particleCount));
-
-            // If the particle doesn't correspond to the recoil electron, 
-            // continue to the next particle.
-            if ((simParticle->getPdgID() == 11) && (simParticle->getParentCount() == 0)) {
-                //std::cout << "[ pnWeightProcessor ]: Recoil electron found." << std::endl;
-                recoilElectron = simParticle; 
+        // Find the recoil electron.  The sim particles are scanned directly
+        // rather than read from the truth summary so the skim doesn't 
+        // depend on truthSummary having been run.
+        SimParticle* recoilElectron{nullptr}; 
+        for (int iParticle = 0; iParticle < simParticles->GetEntriesFast(); ++iParticle) { 
+            SimParticle* particle = static_cast<SimParticle*>(simParticles->At(iParticle)); 
+            if ((particle->getPdgID() == 11) && (particle->getParentCount() == 0)) { 
+                recoilElectron = particle;
                 break;
             }
         }
 
-        // Get the collection of simulated Ecal hits from the event. 
-        const TClonesArray* ecalSimHits = event.getCollection(EventConstants::ECAL_SIM_HITS);
-       
         // Loop through the Ecal hits and check if the recoil electron is 
-        // associated with any of them.  If there are any recoil electron hits
-        // in the Ecal, drop the event.
+        // associated with any of them, comparing the track ID stored with 
+        // each contribution.  Stop at the first recoil electron hit, which 
+        // is enough to drop the event.
         bool hasRecoilElectronHits = false; 
-        for (int iHit = 0; iHit < ecalSimHits->GetEntriesFast(); ++iHit) { 
-            
-            SimCalorimeterHit* simHit = static_cast<SimCalorimeterHit*>(ecalSimHits->At(iHit));
-
-            /*std::cout << "[ RecoilMissesEcalSkimmer ]: "  
-                      << "Number of hit contributions: "  
-                      << simHit->getNumberOfContribs() << std::endl;*/
-
-            for (int iContrib = 0; iContrib < simHit->getNumberOfContribs(); ++iContrib) {
-                SimCalorimeterHit::Contrib contrib = simHit->getContrib(iContrib);
-
-                if (contrib.particle == recoilElectron) { 
-                    /*std::cout << "[ RecoilMissesEcalSkimmer ]: " 
-                              << "Ecal hit associated with recoil electron." << std::endl; */
-                    
-                    hasRecoilElectronHits = true;
-                } 
-            } 
+        if (recoilElectron) { 
+            int recoilTrackID = recoilElectron->getTrackID(); 
+            const TClonesArray* ecalSimHits = event.getCollection(EventConstants::ECAL_SIM_HITS);
+            for (int iHit = 0; iHit < ecalSimHits->GetEntriesFast() && !hasRecoilElectronHits; ++iHit) { 
+                SimCalorimeterHit* hit = static_cast<SimCalorimeterHit*>(ecalSimHits->At(iHit)); 
+                if (hit->getNumberOfContribs() == 0) continue; 
+                if (hit->getContribTrackID(0) >= 0) { 
+                    hasRecoilElectronHits = hit->hasContribFromTrack(recoilTrackID); 
+                } else { 
+                    // Files written before the track IDs were stored only 
+                    // have the particle references to compare against
+                    for (unsigned iContrib = 0; iContrib < hit->getNumberOfContribs(); ++iContrib) { 
+                        if (hit->getContrib(iContrib).particle == recoilElectron) { 
+                            hasRecoilElectronHits = true;
+                            break;
+                        }
+                    }
+                }
+            }
         }
        
         // Tell the skimmer to keep or drop the event based on whether there
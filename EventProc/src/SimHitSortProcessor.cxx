@@ -2,6 +2,7 @@
 #include "TString.h"
 
 // STL
+#include <algorithm>
 #include <cmath>
 
 #include "Event/SimCalorimeterHit.h"
@@ -12,35 +13,63 @@
 namespace ldmx {
 
     void SimHitSortProcessor::configure(const ParameterSet& pSet) {
-        //sortedHits = new TClonesArray(pSet.getString("simHitCollection").c_str(),10000);
-        sortedHits = new TClonesArray(EventConstants::SIM_CALORIMETER_HIT.c_str(),10000);
         collectionName = pSet.getString("simHitCollection");
         outputCollection = pSet.getString("outputCollection");
+        sortBy_ = pSet.getString("sortBy", "edep");
+
+        if (sortBy_ == "edep") {
+            sortVariable_ = EDEP;
+        } else if (sortBy_ == "time") {
+            sortVariable_ = TIME;
+        } else if (sortBy_ == "detID") {
+            sortVariable_ = DETID;
+        } else {
+            EXCEPTION_RAISE("SimHitSortProcessor", "Cannot sort hits by '" + sortBy_ + "', use edep, time or detID.");
+        }
+
+        sortedHits_ = new TClonesArray("ldmx::SortedHitIndices", 1);
     }
 
     void SimHitSortProcessor::produce(Event& event) {
-        TClonesArray* ecalSimHits = (TClonesArray*) event.getCollection(collectionName);
+        const TClonesArray* simHits = event.getCollection(collectionName);
 
-        int numEcalSimHits = ecalSimHits->GetEntries();
-        std::vector<SimCalorimeterHit*> vecSimCaloHit;
+        int numSimHits = simHits->GetEntriesFast();
 
-        for(int iHit = 0; iHit < numEcalSimHits; ++iHit){
-            vecSimCaloHit.push_back((SimCalorimeterHit*)ecalSimHits->At(iHit));
-        }// end loop over sim hits
+        // gather the sort keys in a contiguous array so the sort does not 
+        // chase pointers to the hits
+        if (sortVariable_ == DETID) {
+            intKeys_.resize(numSimHits);
+            for (int iHit = 0; iHit < numSimHits; ++iHit) {
+                intKeys_[iHit] = ((SimCalorimeterHit*) simHits->At(iHit))->getID();
+            }
+            sortIndices(intKeys_);
+        } else {
+            floatKeys_.resize(numSimHits);
+            for (int iHit = 0; iHit < numSimHits; ++iHit) {
+                SimCalorimeterHit* simHit = (SimCalorimeterHit*) simHits->At(iHit);
+                // negate the energy to sort by decreasing energy
+                floatKeys_[iHit] = sortVariable_ == EDEP ? -simHit->getEdep() : simHit->getTime();
+            }
+            sortIndices(floatKeys_);
+        }
 
-        std::sort(vecSimCaloHit.begin(),vecSimCaloHit.end(),[](SimCalorimeterHit* a, SimCalorimeterHit* b) {
-                return a->getEdep() > b->getEdep();   
-            });
+        // add the collection itself rather than a copy of the indices, and
+        // get back the vector cleared with the previous event to reuse it
+        SortedHitIndices* result = (SortedHitIndices*) sortedHits_->ConstructedAt(0);
+        result->set(collectionName, sortBy_);
+        result->setIndices(indices_);
+        event.add(outputCollection, sortedHits_);
+    }
 
-        for(int iHit = 0 ; iHit < vecSimCaloHit.size() ; iHit++){
-            SimCalorimeterHit* simHit = (SimCalorimeterHit*) (sortedHits->ConstructedAt(iHit));
-            simHit->setID( vecSimCaloHit[iHit]->getID() );
-            simHit->setEdep( vecSimCaloHit[iHit]->getEdep() );
-            simHit->setPosition( vecSimCaloHit[iHit]->getPosition()[0] , vecSimCaloHit[iHit]->getPosition()[0] , vecSimCaloHit[iHit]->getPosition()[0] );
-            simHit->setTime( vecSimCaloHit[iHit]->getTime() );
-        }
+    template<typename T>
+    void SimHitSortProcessor::sortIndices(const std::vector<T>& keys) {
+        indices_.resize(keys.size());
+        for (std::size_t index = 0; index < indices_.size(); ++index) indices_[index] = index;
 
-        event.add(outputCollection.c_str(),sortedHits);
+        // ties are broken by the original index to keep the order reproducible
+        std::sort(indices_.begin(), indices_.end(), [&keys](int a, int b) {
+                return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
+            });
     }
 
 }
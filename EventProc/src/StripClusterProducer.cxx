@@ -0,0 +1,148 @@
+/**
+ * @file StripClusterProducer.cxx
+ * @brief Processor that clusters the recoil tracker Si strip hits of
+ *        neighboring strips.
+ */
+
+#include "EventProc/StripClusterProducer.h"
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <algorithm>
+#include <cmath>
+
+namespace ldmx {
+
+    const int StripClusterProducer::MAX_LAYERS;
+
+    StripClusterProducer::StripClusterProducer(const std::string& name, Process& process) :
+        Producer(name, process) {
+    }
+
+    StripClusterProducer::~StripClusterProducer() {
+    }
+
+    void StripClusterProducer::configure(const ParameterSet &pSet) {
+
+        inputCollection_ = pSet.getString("input_collection", inputCollection_);
+        outputCollection_ = pSet.getString("output_collection", outputCollection_);
+        stripPitch_ = pSet.getDouble("strip_pitch", stripPitch_);
+        maxStripGap_ = pSet.getInteger("max_strip_gap", maxStripGap_);
+
+        if (stripPitch_ <= 0) {
+            EXCEPTION_RAISE("StripClusterProducer", "The strip pitch must be positive.");
+        }
+        if (maxStripGap_ < 0) {
+            EXCEPTION_RAISE("StripClusterProducer", "The maximum strip gap can't be negative.");
+        }
+
+        // Stereo angle of each layer in radians, starting with layer ID 1.
+        // The default is the v3 recoil tracker, whose layers 1-8 are the
+        // axial and stereo sensors of the four modules with stereo angles
+        // of +/-0.1 rad.
+        std::vector<double> stereoAngles = pSet.getVDouble("layer_stereo_angles",
+                {0, 0.1, 0, -0.1, 0, 0.1, 0, -0.1});
+        if (stereoAngles.size() >= MAX_LAYERS) {
+            EXCEPTION_RAISE("StripClusterProducer", "Too many layer stereo angles.");
+        }
+        stereoCos_.assign(MAX_LAYERS, 1.);
+        stereoSin_.assign(MAX_LAYERS, 0.);
+        for (std::size_t iLayer = 0; iLayer < stereoAngles.size(); ++iLayer) {
+            stereoCos_[iLayer + 1] = cos(stereoAngles[iLayer]);
+            stereoSin_[iLayer + 1] = sin(stereoAngles[iLayer]);
+        }
+
+        clusters_ = new TClonesArray("ldmx::SiStripHit", 1000);
+    }
+
+    void StripClusterProducer::produce(Event& event) {
+
+        const TClonesArray* stripHits = event.getCollection(inputCollection_);
+
+        entries_.clear();
+        for (int iHit = 0; iHit < stripHits->GetEntriesFast(); ++iHit) {
+            SiStripHit* stripHit = static_cast<SiStripHit*>(stripHits->At(iHit));
+            TRefArray* simHits = stripHit->getSimTrackerHits();
+            for (int iSimHit = 0; iSimHit < simHits->GetEntriesFast(); ++iSimHit) {
+                SimTrackerHit* simHit = static_cast<SimTrackerHit*>(simHits->At(iSimHit));
+                if (simHit) addEntry(simHit);
+            }
+        }
+
+        std::sort(entries_.begin(), entries_.end());
+
+        // Sweep the sorted hits, closing a cluster whenever the sensor changes
+        // or the next hit is too many strips away from the last one
+        int iCluster = 0;
+        std::size_t begin = 0;
+        for (std::size_t iEntry = 1; iEntry <= entries_.size(); ++iEntry) {
+            if (iEntry < entries_.size()) {
+                const StripEntry &entry = entries_[iEntry];
+                const StripEntry &previous = entries_[iEntry - 1];
+                if (entry.layer == previous.layer && entry.module == previous.module
+                        && entry.strip - previous.strip <= maxStripGap_ + 1) continue;
+            }
+            SiStripHit* cluster = static_cast<SiStripHit*>(clusters_->ConstructedAt(iCluster));
+            cluster->Clear();
+            fillCluster(cluster, begin, iEntry);
+            begin = iEntry;
+            ++iCluster;
+        }
+
+        event.add(outputCollection_, clusters_);
+    }
+
+    void StripClusterProducer::addEntry(SimTrackerHit* hit) {
+
+        int layer = hit->getLayerID();
+        int stereoLayer = (layer >= 0 && layer < MAX_LAYERS) ? layer : 0;
+
+        // Project the position on the measurement direction of the layer
+        double u = hit->getX()*stereoCos_[stereoLayer] + hit->getY()*stereoSin_[stereoLayer];
+
+        StripEntry entry;
+        entry.layer = layer;
+        entry.module = hit->getModuleID();
+        entry.strip = static_cast<int>(floor(u/stripPitch_));
+        entry.order = entries_.size();
+        entry.hit = hit;
+        entries_.push_back(entry);
+    }
+
+    void StripClusterProducer::fillCluster(SiStripHit* cluster, std::size_t begin, std::size_t end) const {
+
+        float charge{0};
+        float time{entries_[begin].hit->getTime()};
+        double sumX{0}, sumY{0}, sumZ{0};
+        double meanX{0}, meanY{0}, meanZ{0};
+        for (std::size_t iEntry = begin; iEntry < end; ++iEntry) {
+            SimTrackerHit* hit = entries_[iEntry].hit;
+            float edep = hit->getEdep();
+            charge += edep;
+            sumX += edep*hit->getX();
+            sumY += edep*hit->getY();
+            sumZ += edep*hit->getZ();
+            meanX += hit->getX();
+            meanY += hit->getY();
+            meanZ += hit->getZ();
+            time = std::min(time, hit->getTime());
+            cluster->addSimTrackerHit(hit);
+        }
+
+        // Use the unweighted mean position if there is no charge
+        if (charge > 0) {
+            cluster->setPosition(sumX/charge, sumY/charge, sumZ/charge);
+        } else {
+            int nHits = end - begin;
+            cluster->setPosition(meanX/nHits, meanY/nHits, meanZ/nHits);
+        }
+
+        cluster->setSensor(entries_[begin].layer, entries_[begin].module);
+        cluster->setStrips(entries_[begin].strip, entries_[end - 1].strip);
+        cluster->setCharge(charge);
+        cluster->setTime(time);
+    }
+}
+
+DECLARE_PRODUCER_NS(ldmx, StripClusterProducer)
@@ -18,10 +18,41 @@ namespace ldmx {
 
     void TrackerHitKiller::configure(const ParameterSet &pSet) { 
        
-        // Get the hit efficiency. For now, this will be an integer quantiy 
-        // in the range 0-100.  If more precision is needed in the future, 
-        // this can be updated.
-        hitEff_ = int(pSet.getDouble("hitEfficiency"));
+        // The efficiencies are given as percentages.  The default hit 
+        // efficiency applies to every sensor unless it is overridden for 
+        // a whole layer or for a single sensor.
+        hitEff_ = pSet.getDouble("hitEfficiency")/100.;
+        efficiencies_.assign(MAX_LAYERS*MAX_SENSORS, hitEff_); 
+
+        // Efficiency of each layer, starting with layer ID 1
+        std::vector<double> layerEffs = pSet.getVDouble("layerEfficiencies", {}); 
+        if (layerEffs.size() >= MAX_LAYERS) { 
+            EXCEPTION_RAISE("TrackerHitKiller", "Too many layer efficiencies."); 
+        }
+        for (int iLayer = 0; iLayer < layerEffs.size(); ++iLayer) { 
+            std::fill(efficiencies_.begin() + (iLayer + 1)*MAX_SENSORS, 
+                    efficiencies_.begin() + (iLayer + 2)*MAX_SENSORS, layerEffs[iLayer]/100.); 
+        }
+
+        // Efficiency of single sensors, given by their layer and module IDs
+        std::vector<int> sensorLayers = pSet.getVInteger("sensorEfficiencyLayers", {}); 
+        std::vector<int> sensorModules = pSet.getVInteger("sensorEfficiencyModules", {}); 
+        std::vector<double> sensorEffs = pSet.getVDouble("sensorEfficiencies", {}); 
+        if (sensorLayers.size() != sensorEffs.size() || sensorModules.size() != sensorEffs.size()) { 
+            EXCEPTION_RAISE("TrackerHitKiller", 
+                    "The sensor efficiency layers, modules and efficiencies must have the same length."); 
+        }
+        for (int iSensor = 0; iSensor < sensorEffs.size(); ++iSensor) { 
+            int layer = sensorLayers[iSensor];
+            int module = sensorModules[iSensor];
+            if (layer < 0 || layer >= MAX_LAYERS || module < 0 || module >= MAX_SENSORS) { 
+                EXCEPTION_RAISE("TrackerHitKiller", "Sensor efficiency given for an invalid layer or module ID."); 
+            }
+            efficiencies_[layer*MAX_SENSORS + module] = sensorEffs[iSensor]/100.; 
+        }
+
+        hitCounts_.assign(MAX_LAYERS + 1, 0); 
+        droppedCounts_.assign(MAX_LAYERS + 1, 0); 
 
         // Instantiate the collection of Si strip hits 
         siStripHits_ = new TClonesArray("ldmx::SiStripHit", 10000); 
@@ -35,20 +66,46 @@ namespace ldmx {
         int iHit = 0;
         for (int hitCount = 0; hitCount < recoilSimHits->GetEntriesFast(); ++hitCount) { 
             
-            if (random_->Integer(100) >= hitEff_) { 
-                std::cout << "[ TrackerHitKiller ]: Dropping hit." << std::endl;
+            SimTrackerHit* simHit = static_cast<SimTrackerHit*>(recoilSimHits->At(hitCount));
+            int layer = simHit->getLayerID(); 
+
+            // Hits in layers outside of the map are counted together
+            int counter = (layer >= 0 && layer < MAX_LAYERS) ? layer : MAX_LAYERS;
+            ++hitCounts_[counter]; 
+
+            if (random_->Uniform() >= getEfficiency(layer, simHit->getModuleID())) { 
+                ++droppedCounts_[counter];
                 continue;
-            } else {
-                // Get the SimTrackerHit from the collection of recoil sim hits.
-                SiStripHit* stripHit = static_cast<SiStripHit*>(siStripHits_->ConstructedAt(iHit));
-               stripHit->addSimTrackerHit(static_cast<SimTrackerHit*>(recoilSimHits->At(hitCount))); 
-                ++iHit;
             }
+
+            // Get the SimTrackerHit from the collection of recoil sim hits.
+            SiStripHit* stripHit = static_cast<SiStripHit*>(siStripHits_->ConstructedAt(iHit));
+            stripHit->addSimTrackerHit(simHit); 
+            stripHit->setSensor(layer, simHit->getModuleID()); 
+            stripHit->setCharge(simHit->getEdep()); 
+            stripHit->setPosition(simHit->getX(), simHit->getY(), simHit->getZ()); 
+            stripHit->setTime(simHit->getTime()); 
+            ++iHit;
         }
 
         //Add the result to the collection
         event.add("SiStripHits", siStripHits_);
     }
+
+    void TrackerHitKiller::onProcessEnd() { 
+
+        long totalHits{0}; 
+        long totalDropped{0}; 
+        std::cout << "[ TrackerHitKiller ]: Dropped hits per layer" << std::endl;
+        for (int layer = 0; layer <= MAX_LAYERS; ++layer) { 
+            if (hitCounts_[layer] == 0) continue;
+            totalHits += hitCounts_[layer];
+            totalDropped += droppedCounts_[layer];
+            std::cout << "\t" << (layer < MAX_LAYERS ? "Layer " + std::to_string(layer) : std::string("Other layers")) 
+                      << ": " << droppedCounts_[layer] << " / " << hitCounts_[layer] << std::endl;
+        }
+        std::cout << "\tTotal: " << totalDropped << " / " << totalHits << std::endl;
+    }
 }
 
 DECLARE_PRODUCER_NS(ldmx, TrackerHitKiller) 
@@ -2,27 +2,71 @@
 #include "TString.h"
 
 // STL
+#include <algorithm>
 #include <cmath>
+#include <iostream>
 
 #include "Event/TriggerResult.h"
 #include "Event/EcalHit.h"
+#include "Event/EventConstants.h"
 #include "EventProc/TriggerProcessor.h"
 #include "Framework/EventProcessor.h"
+#include "DetDescr/EcalDetectorID.h"
 #include "DetDescr/EcalHexReadout.h"
 
 namespace ldmx {
 
+    const int TriggerProcessor::MAX_LAYERS;
+
     void TriggerProcessor::configure(const ParameterSet& pSet) {
 
         layerESumCut_ = pSet.getDouble("threshold");
         mode_ = pSet.getInteger("mode");
         startLayer_ = pSet.getInteger("start_layer");
         endLayer_ = pSet.getInteger("end_layer");
+        centerTowerCut_ = pSet.getDouble("center_tower_threshold", layerESumCut_);
+        totalECut_ = pSet.getDouble("total_energy_threshold", layerESumCut_);
 
-        if (mode_ == 0) {
+        if (mode_ == LAYER_SUM) {
             algoName_ = "LayerSumTrig";
-        } else if (mode_ == 1) {
+        } else if (mode_ == CENTER_TOWER) {
             algoName_ = "CenterTower";
+        } else if (mode_ == TOTAL_ENERGY) {
+            algoName_ = "TotalETrig";
+        } else {
+            EXCEPTION_RAISE("TriggerProcessor", "Unknown trigger mode " + std::to_string(mode_) + ".");
+        }
+
+        startLayer_ = std::max(startLayer_, 0);
+        endLayer_ = std::min(endLayer_, MAX_LAYERS);
+
+        centerTowerRadius_ = pSet.getDouble("center_tower_radius", centerTowerRadius_);
+        buildCenterTower(EcalHexReadout::getInstance());
+    }
+
+    void TriggerProcessor::onNewRun(const RunHeader& runHeader) {
+        const EcalHexReadout* hexReadout{nullptr};
+        try {
+            hexReadout = &EcalHexReadout::getInstance(EcalHexReadout::getRunGeometry(runHeader.getDetectorName(),
+                        runHeader.getFloatParameter(EventConstants::ECAL_HEX_RADIUS),
+                        runHeader.getFloatParameter(EventConstants::ECAL_HEX_GAP)));
+        } catch (const std::invalid_argument& e) {
+            EXCEPTION_RAISE("TriggerProcessor", e.what());
+        }
+        buildCenterTower(*hexReadout);
+    }
+
+    void TriggerProcessor::buildCenterTower(const EcalHexReadout& hexReadout) {
+
+        // the center tower is made of the cells of the center module 
+        // whose center is within the tower radius
+        centerTowerCells_.clear();
+        for (auto const& cell : hexReadout.getCellPositionMap()) {
+            std::size_t cellID = cell.first;
+            double x = cell.second.first;
+            double y = cell.second.second;
+            if (cellID >= centerTowerCells_.size()) centerTowerCells_.resize(cellID + 1, false);
+            centerTowerCells_[cellID] = (sqrt(x*x + y*y) < centerTowerRadius_);
         }
     }
 
@@ -32,37 +76,56 @@ namespace ldmx {
         const TClonesArray *ecalDigis = event.getCollection("ecalDigis");
         int numEcalHits = ecalDigis->GetEntriesFast();
 
-        std::vector<double> layerDigiE(100, 0.0); // big empty vector..
+        std::fill(layerE_, layerE_ + MAX_LAYERS, 0.0);
+        std::fill(layerTowerE_, layerTowerE_ + MAX_LAYERS, 0.0);
+        double totalE = 0;
 
         /** Loop over all ecal hits in the given event */
         for (int iHit = 0; iHit < numEcalHits; ++iHit) {
             EcalHit *hit = (EcalHit*) ecalDigis->At(iHit);
-            if (hit->getLayer() < layerDigiE.size()) { // just to be safe...
-                if (mode_ == 0) { // Sum over all cells in a given layer
-                    layerDigiE[hit->getLayer()] += hit->getEnergy();
-                } else if (mode_ == 1) { // Sum over cells in central tower only
-                    //std::pair<float, float> xyPos = hit->getCellCentroidXYPair(hit->getID());
-                    //float cellRadius = sqrt(pow(xyPos.first, 2) + pow(xyPos.second, 2));
-                    //if (cellRadius < MAGICNUMBERHERE) {
-                    //    layerDigiE[hit->getLayer()] += hit->getEnergy();
-                    //}
-                }
+            int detIDraw = hit->getID();
+            int layer = EcalDetectorID::LayerField::decode(detIDraw);
+            double energy = hit->getEnergy();
+
+            totalE += energy;
+            if (layer >= MAX_LAYERS) continue; // just to be safe...
+
+            layerE_[layer] += energy;
+
+            // the center tower is in the center module, which has module ID 0
+            int module = EcalDetectorID::ModuleField::decode(detIDraw);
+            unsigned cell = EcalDetectorID::CellField::decode(detIDraw);
+            if (module == 0 && cell < centerTowerCells_.size() && centerTowerCells_[cell]) {
+                layerTowerE_[layer] += energy;
             }
         }
 
-        float layerSum = 0;
-        bool pass = false;
-
+        double layerSum = 0;
+        double towerSum = 0;
         for (int iL = startLayer_; iL < endLayer_; ++iL) {
-            layerSum += layerDigiE[iL];
+            layerSum += layerE_[iL];
+            towerSum += layerTowerE_[iL];
         }
 
-        pass = (layerSum <= layerESumCut_);
+        int passMask = 0;
+        if (layerSum <= layerESumCut_) passMask |= 1 << LAYER_SUM;
+        if (towerSum <= centerTowerCut_) passMask |= 1 << CENTER_TOWER;
+        if (totalE <= totalECut_) passMask |= 1 << TOTAL_ENERGY;
+
+        bool pass = passMask & (1 << mode_);
 
-        result_.set(algoName_, pass, 3);
+        result_.set(algoName_, pass, LAYER_VARS_OFFSET + MAX_LAYERS);
         result_.setAlgoVar(0, layerSum);
         result_.setAlgoVar(1, layerESumCut_);
         result_.setAlgoVar(2, endLayer_ - startLayer_);
+        result_.setAlgoVar(3, towerSum);
+        result_.setAlgoVar(4, centerTowerCut_);
+        result_.setAlgoVar(5, totalE);
+        result_.setAlgoVar(6, totalECut_);
+        result_.setAlgoVar(7, passMask);
+        for (int iL = 0; iL < MAX_LAYERS; ++iL) {
+            result_.setAlgoVar(LAYER_VARS_OFFSET + iL, layerE_[iL]);
+        }
 
         event.addToCollection("Trigger", result_);
 
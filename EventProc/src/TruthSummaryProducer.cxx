@@ -0,0 +1,143 @@
+/**
+ * @file TruthSummaryProducer.cxx
+ * @brief Processor that summarizes the Monte Carlo truth of an event for
+ *        downstream processors.
+ */
+
+#include "EventProc/TruthSummaryProducer.h"
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <algorithm>
+#include <cstdlib>
+
+namespace ldmx { 
+
+    TruthSummaryProducer::TruthSummaryProducer(const std::string &name, Process &process) :
+            Producer(name, process) {
+    }
+
+    TruthSummaryProducer::~TruthSummaryProducer() { 
+    }
+
+    void TruthSummaryProducer::configure(const ParameterSet &pSet) { 
+        ecalSimHitCollection_ = pSet.getString("ecal_sim_hit_collection", ecalSimHitCollection_); 
+    }
+
+    void TruthSummaryProducer::produce(Event &event) {
+
+        summary_.Clear();
+
+        // Map the sim particles to their index in the collection
+        const TClonesArray* simParticles = event.getCollection(EventConstants::SIM_PARTICLES);
+        int nParticles = simParticles->GetEntriesFast(); 
+
+        particleIndices_.clear();
+        for (int index = 0; index < nParticles; ++index) { 
+            particleIndices_.emplace_back(static_cast<const SimParticle*>(simParticles->At(index)), index);
+        }
+        std::sort(particleIndices_.begin(), particleIndices_.end()); 
+
+        // The recoil electron is the electron which doesn't have any parents
+        for (int index = 0; index < nParticles; ++index) { 
+            SimParticle* simParticle = static_cast<SimParticle*>(simParticles->At(index));
+            if ((simParticle->getPdgID() == 11) && (simParticle->getParentCount() == 0)) {
+                summary_.setRecoilElectronIndex(index);
+                break;
+            }
+        }
+
+        if (summary_.getRecoilElectronIndex() >= 0) this->findPnParticles(simParticles);
+
+        if (event.exists(ecalSimHitCollection_)) { 
+            this->buildEcalHitLists(event.getCollection(ecalSimHitCollection_), nParticles); 
+        }
+
+        event.addToCollection(EventConstants::TRUTH_SUMMARY, summary_);
+    }
+
+    int TruthSummaryProducer::getParticleIndex(const SimParticle* simParticle) const { 
+        auto it = std::lower_bound(particleIndices_.begin(), particleIndices_.end(), 
+                std::make_pair(simParticle, -1)); 
+        if (it == particleIndices_.end() || it->first != simParticle) return -1; 
+        return it->second;
+    }
+
+    void TruthSummaryProducer::findPnParticles(const TClonesArray* simParticles) { 
+
+        SimParticle* recoilElectron 
+            = static_cast<SimParticle*>(simParticles->At(summary_.getRecoilElectronIndex()));
+
+        // Search for the PN gamma among the daughters of the recoil electron
+        SimParticle* pnGamma{nullptr};
+        for (int daughterCount = 0; daughterCount < recoilElectron->getDaughterCount(); ++daughterCount) {
+            SimParticle* daughter = recoilElectron->getDaughter(daughterCount);
+            if ((daughter->getDaughterCount() > 0) && 
+                    (daughter->getDaughter(0)->getProcessType() == SimParticle::ProcessType::photonNuclear)) {
+                pnGamma = daughter; 
+                break;
+            }
+        }
+        if (pnGamma == nullptr) return; 
+
+        summary_.setPnGammaIndex(getParticleIndex(pnGamma)); 
+
+        // Find the nucleon with the greatest kinetic energy
+        double hardestNucleonKe{-9999};
+        for (int pnDaughterCount = 0; pnDaughterCount < pnGamma->getDaughterCount(); ++pnDaughterCount) { 
+            SimParticle* pnDaughter = pnGamma->getDaughter(pnDaughterCount);
+            
+            int pdgID = std::abs(pnDaughter->getPdgID());
+            if ((pdgID != PROTON_PDGID) && (pdgID != NEUTRON_PDGID)) continue;
+
+            double ke = pnDaughter->getEnergy() - pnDaughter->getMass();
+            if (ke > hardestNucleonKe) { 
+                hardestNucleonKe = ke;
+                summary_.setHardestNucleonIndex(getParticleIndex(pnDaughter)); 
+            }
+        }
+    }
+
+    void TruthSummaryProducer::buildEcalHitLists(const TClonesArray* ecalSimHits, int nParticles) { 
+
+        // First pass: resolve the particle of each contribution once and 
+        // count the hits of each particle.  A particle can make several 
+        // contributions to a hit (with different PDG codes) so only its last 
+        // hit is compared against.
+        contribParticles_.clear();
+        hitOffsets_.assign(nParticles + 1, 0);
+        std::vector<int> lastHit(nParticles, -1);
+        for (int iHit = 0; iHit < ecalSimHits->GetEntriesFast(); ++iHit) { 
+            SimCalorimeterHit* simHit = static_cast<SimCalorimeterHit*>(ecalSimHits->At(iHit));
+            for (int iContrib = 0; iContrib < simHit->getNumberOfContribs(); ++iContrib) {
+                int particleIndex = getParticleIndex(simHit->getContrib(iContrib).particle);
+                contribParticles_.push_back(particleIndex); 
+                if (particleIndex < 0 || lastHit[particleIndex] == iHit) continue; 
+                lastHit[particleIndex] = iHit; 
+                hitOffsets_[particleIndex + 1]++;
+            }
+        }
+
+        for (int index = 0; index < nParticles; ++index) hitOffsets_[index + 1] += hitOffsets_[index];
+
+        // Second pass: fill the hit lists
+        hitIndices_.resize(hitOffsets_[nParticles]);
+        std::vector<int> next(hitOffsets_.begin(), hitOffsets_.end() - 1);
+        std::fill(lastHit.begin(), lastHit.end(), -1);
+        int contribCount{0};
+        for (int iHit = 0; iHit < ecalSimHits->GetEntriesFast(); ++iHit) { 
+            SimCalorimeterHit* simHit = static_cast<SimCalorimeterHit*>(ecalSimHits->At(iHit));
+            for (int iContrib = 0; iContrib < simHit->getNumberOfContribs(); ++iContrib) {
+                int particleIndex = contribParticles_[contribCount++];
+                if (particleIndex < 0 || lastHit[particleIndex] == iHit) continue; 
+                lastHit[particleIndex] = iHit; 
+                hitIndices_[next[particleIndex]++] = iHit;
+            }
+        }
+
+        summary_.setEcalHits(hitOffsets_, hitIndices_); 
+    }
+}
+
+DECLARE_PRODUCER_NS(ldmx, TruthSummaryProducer) 
@@ -0,0 +1,197 @@
+/**
+ * @file ecal_digi_bench.cxx
+ * @brief Times the ECal digitization of 5k-hit events against the per-hit
+ *        noise, calibration and noise-hit ID generation it replaced.
+ *
+ * Both versions digitize the same sim hits, and their calibrated energies
+ * are compared for hits well above threshold, so a digitization speed-up
+ * can only be accepted if this program runs through.
+ */
+
+// LDMX
+#include "DetDescr/EcalDetectorID.h"
+#include "Event/EcalHit.h"
+#include "Event/EventConstants.h"
+#include "Event/SimCalorimeterHit.h"
+#include "EventProc/EcalDigiProducer.h"
+#include "Framework/EventImpl.h"
+#include "Framework/ParameterSet.h"
+#include "Framework/Process.h"
+#include "Tools/NoiseGenerator.h"
+
+// ROOT
+#include "TClonesArray.h"
+#include "TRandom3.h"
+
+// STL
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using ldmx::EcalDetectorID;
+using ldmx::EcalDigiProducer;
+using ldmx::EcalHit;
+using ldmx::SimCalorimeterHit;
+
+typedef std::chrono::high_resolution_clock Clock;
+
+/** @return The time since start [ns]. */
+double elapsed(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+/** Sampling weights of the ECal layers. */
+static const std::vector<double> LAYER_WEIGHTS
+    = {1.641, 3.526, 5.184, 6.841,
+    8.222, 8.775, 8.775, 8.775, 8.775, 8.775, 8.775, 8.775, 8.775, 8.775,
+    8.775, 8.775, 8.775, 8.775, 8.775, 8.775, 8.775, 8.775, 12.642, 16.51,
+    16.51, 16.51, 16.51, 16.51, 16.51, 16.51, 16.51, 16.51, 8.45};
+
+/**
+ * The digitization before the calibration table and the block noise: one
+ * Gaussian draw, ID decode and divide per sim hit, and three random integers
+ * and an ID pack per noise hit.
+ */
+void referenceDigitization(const TClonesArray& simHits, double noiseRMS, double readoutThreshold,
+        TRandom3& noiseInjector, ldmx::NoiseGenerator& noiseGenerator, TClonesArray& digis) {
+
+    EcalDetectorID detID;
+    int numSimHits = simHits.GetEntriesFast();
+    for (int iHit = 0; iHit < numSimHits; iHit++) {
+        SimCalorimeterHit* simHit = (SimCalorimeterHit*) simHits.At(iHit);
+        double hitNoise = noiseInjector.Gaus(0, noiseRMS);
+        detID.setRawValue(simHit->getID());
+        detID.unpack();
+        int layer = detID.getFieldValue("layer");
+
+        EcalHit* digiHit = (EcalHit*) digis.ConstructedAt(iHit);
+        digiHit->setID(simHit->getID());
+        double energy = simHit->getEdep() + hitNoise;
+        digiHit->setAmplitude(energy);
+        if (energy > readoutThreshold) {
+            digiHit->setEnergy(((energy/EcalDigiProducer::MIP_SI_RESPONSE)*LAYER_WEIGHTS[layer] + energy)*0.948);
+            digiHit->setTime(simHit->getTime());
+        } else {
+            digiHit->setEnergy(0);
+            digiHit->setTime(-1000);
+        }
+    }
+
+    std::vector<double> noiseHits = noiseGenerator.generateNoiseHits(33*7*397 - numSimHits);
+    int iHit = numSimHits;
+    for (double noiseHit : noiseHits) {
+        EcalHit* digiHit = (EcalHit*) digis.ConstructedAt(iHit);
+        digiHit->setAmplitude(noiseHit);
+        int layerID = noiseInjector.Integer(33);
+        int moduleID = noiseInjector.Integer(7);
+        int cellID = noiseInjector.Integer(397);
+        detID.setFieldValue(1, layerID);
+        detID.setFieldValue(2, moduleID);
+        detID.setFieldValue(3, cellID);
+        digiHit->setID(detID.pack());
+        digiHit->setEnergy(((noiseHit/EcalDigiProducer::MIP_SI_RESPONSE)*LAYER_WEIGHTS[layerID] + noiseHit)*0.948);
+        digiHit->setNoiseHit(true);
+        ++iHit;
+    }
+}
+
+int main(int, const char* argv[])  {
+
+    std::cout << "Hello ECal digi benchmark!" << std::endl;
+
+    const int nSimHits = 5000;
+    const int nEvents = 200;
+
+    /*
+     * Configure the producer as in ecalDigis.py, with a fixed seed.
+     */
+    ldmx::Process process("bench");
+    EcalDigiProducer digiProducer("ecalDigis", process);
+    ldmx::ParameterSet parameters;
+    parameters.insert("noiseIntercept", 900.);
+    parameters.insert("noiseSlope", 22.);
+    parameters.insert("padCapacitance", 27.56);
+    parameters.insert("readoutThreshold", 4.);
+    parameters.insert("randomSeed", 1);
+    digiProducer.configure(parameters);
+
+    double noiseRMS = (900. + 22.*27.56)*(EcalDigiProducer::MIP_SI_RESPONSE/EcalDigiProducer::ELECTRONS_PER_MIP);
+    double readoutThreshold = 4.*noiseRMS;
+
+    /*
+     * Fill an event with sim hits in distinct random channels.
+     */
+    std::mt19937 generator(20190601);
+    std::uniform_int_distribution<int> channelDistribution(0, 33*7*397 - 1);
+    std::exponential_distribution<double> edepDistribution(1./(10*noiseRMS));
+    std::vector<bool> usedChannels(33*7*397, false);
+    TClonesArray* simHits = new TClonesArray("ldmx::SimCalorimeterHit", nSimHits);
+    for (int iHit = 0; iHit < nSimHits; ++iHit) {
+        int channel = channelDistribution(generator);
+        while (usedChannels[channel]) channel = channelDistribution(generator);
+        usedChannels[channel] = true;
+        SimCalorimeterHit* simHit = (SimCalorimeterHit*) simHits->ConstructedAt(iHit);
+        simHit->setID(EcalDetectorID::encode(1, channel/(7*397), (channel/397)%7, channel%397));
+        simHit->setEdep(edepDistribution(generator));
+        simHit->setTime(1.);
+    }
+
+    ldmx::EventImpl event("bench");
+    event.createTree();
+    event.add(ldmx::EventConstants::ECAL_SIM_HITS, simHits);
+
+    /*
+     * Time the producer and the reference digitization of the same hits.
+     */
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < nEvents; ++i) {
+        event.getEventHeaderMutable().setEventNumber(i);
+        digiProducer.produce(event);
+        event.onEndOfEvent();
+    }
+    double digiTime = elapsed(start)/nEvents;
+
+    TRandom3 noiseInjector(1);
+    ldmx::NoiseGenerator noiseGenerator;
+    noiseGenerator.setNoise(noiseRMS);
+    noiseGenerator.setPedestal(0);
+    noiseGenerator.setNoiseThreshold(readoutThreshold);
+    TClonesArray referenceDigis("ldmx::EcalHit", 10000);
+    start = Clock::now();
+    for (int i = 0; i < nEvents; ++i) {
+        referenceDigitization(*simHits, noiseRMS, readoutThreshold, noiseInjector, noiseGenerator, referenceDigis);
+    }
+    double referenceTime = elapsed(start)/nEvents;
+
+    /*
+     * The noise differs between the two, so only compare the calibration
+     * of hits far enough above threshold that it can't push them below.
+     */
+    const TClonesArray* digis = event.getCollection("ecalDigis");
+    int nCompared = 0;
+    for (int iHit = 0; iHit < nSimHits; ++iHit) {
+        const EcalHit* digi = (const EcalHit*) digis->At(iHit);
+        const EcalHit* reference = (const EcalHit*) referenceDigis.At(iHit);
+        if (digi->getID() != reference->getID()) {
+            throw std::runtime_error("The digi of sim hit " + std::to_string(iHit) + " has the wrong ID");
+        }
+        if (digi->getAmplitude() < 2*readoutThreshold || reference->getAmplitude() < 2*readoutThreshold) continue;
+        double calibration = digi->getEnergy()/digi->getAmplitude();
+        double referenceCalibration = reference->getEnergy()/reference->getAmplitude();
+        if (std::abs(calibration - referenceCalibration) > 1e-5*referenceCalibration) {
+            throw std::runtime_error("The digi of sim hit " + std::to_string(iHit) + " has the wrong calibration");
+        }
+        ++nCompared;
+    }
+    std::cout << "calibration matches the reference for " << nCompared << " hits" << std::endl;
+
+    std::cout << "reference digitization: " << referenceTime/1E3 << " us/event (" << nSimHits << " sim hits)" << std::endl;
+    std::cout << "EcalDigiProducer::produce: " << digiTime/1E3 << " us/event (" << nSimHits << " sim hits)" << std::endl;
+    std::cout << "speed-up: " << referenceTime/digiTime << std::endl;
+
+    return 0;
+}
@@ -105,15 +105,19 @@ namespace ldmx {
                         // notify for new run if necessary
                         if (theEvent.getEventHeader()->getRun() != wasRun) {
                             wasRun = theEvent.getEventHeader()->getRun();
+                            const RunHeader* runHeader{nullptr};
                             try {
-                                const RunHeader& runHeader = masterFile->getRunHeader(wasRun);
+                                runHeader = &masterFile->getRunHeader(wasRun);
+                            } catch (const Exception&) {
+                                std::cout << "[Process] [WARNING] Run header for run " << wasRun << " was not found!" << std::endl;
+                            }
+                            // errors of the processors are fatal, unlike a missing run header
+                            if (runHeader) {
                                 std::cout << "[Process] got new run header from '" << masterFile->getFileName() << "' ..." << std::endl;
-                                runHeader.Print();
+                                runHeader->Print();
                                 for (auto module : sequence_) {
-                                    module->onNewRun(runHeader);
+                                    module->onNewRun(*runHeader);
                                 }
-                            } catch (const Exception&) {
-                                std::cout << "[Process] [WARNING] Run header for run " << wasRun << " was not found!" << std::endl;
                             }
                         }
 
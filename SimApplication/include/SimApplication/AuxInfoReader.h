@@ -12,6 +12,7 @@
 
 // LDMX
 #include "DetDescr/DetectorHeader.h"
+#include "DetDescr/EcalHexReadout.h"
 
 namespace ldmx {
 
@@ -59,6 +60,13 @@ namespace ldmx {
                 return detectorHeader_;
             }
 
+            /**
+             * Get the ECal geometry from the Hex_radius and hexagon_gap GDML variables,
+             * or from the detector name for older GDML without them.
+             * @return The ECal geometry parameters.
+             */
+            const EcalHexReadout::Geometry& getEcalGeometry();
+
         private:
 
             /**
@@ -119,6 +127,16 @@ namespace ldmx {
              * Detector header with name and version.
              */
             ldmx::DetectorHeader* detectorHeader_ {nullptr};
+
+            /**
+             * The ECal geometry, set on first use.
+             */
+            EcalHexReadout::Geometry ecalGeometry_;
+
+            /**
+             * Whether the ECal geometry was set.
+             */
+            bool hasEcalGeometry_ {false};
     };
 
 }
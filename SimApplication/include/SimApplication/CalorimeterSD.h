@@ -14,6 +14,7 @@
 #include "Event/Event.h"
 #include "SimApplication/G4CalorimeterHit.h"
 #include "DetDescr/DetectorID.h"
+#include "DetDescr/IDCodec.h"
 
 using ldmx::DetectorID;
 using ldmx::Event;
@@ -33,9 +34,9 @@ namespace ldmx {
              * @param name The name of the calorimeter.
              * @param theCollectionName The name of the hits collection.
              * @param subdet The subdetector ID.
-             * @param detID The detector ID.
+             * @param idCodec The codec of the detector ID, which is copied.
              */
-            CalorimeterSD(G4String name, G4String theCollectionName, int subdet, DetectorID* detID);
+            CalorimeterSD(G4String name, G4String theCollectionName, int subdet, const IDCodec& idCodec);
 
             /**
              * Class destructor.
@@ -82,9 +83,17 @@ namespace ldmx {
             int subdet_;
 
             /**
-             * The detector ID.
+             * The codec of the detector ID.  Hit IDs are packed into local
+             * values, so processing hits writes no state shared with other
+             * sensitive detectors.
              */
-            DetectorID* detID_;
+            IDCodec idCodec_;
+
+            /**
+             * The ID with only the subdetector field set, which is the same
+             * for every hit.
+             */
+            IDCodec::RawValue subdetRawID_{0};
 
             /**
              * The depth to the layer volume.
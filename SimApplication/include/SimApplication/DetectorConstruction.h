@@ -68,6 +68,14 @@ namespace ldmx {
                 return auxInfoReader_->getDetectorHeader();
             }
 
+            /**
+             * Get the ECal geometry.
+             * @return The ECal geometry parameters.
+             */
+            const EcalHexReadout::Geometry& getEcalGeometry() {
+                return auxInfoReader_->getEcalGeometry();
+            }
+
         private:
 
             /**
@@ -20,6 +20,7 @@
 
 // STL
 #include <utility>
+#include <vector>
 
 namespace ldmx {
 
@@ -88,6 +89,17 @@ namespace ldmx {
                 compressHitContribs_ = compressHitContribs;
             }
 
+            /**
+             * Set the hex readout of the detector's ECal geometry.
+             * @param hexReadout The shared hex readout.
+             */
+            void setHexReadout(const EcalHexReadout& hexReadout) {
+                hexReadout_ = &hexReadout;
+                // the channel slots depend on the readout
+                channelHits_.clear();
+                usedSlots_.clear();
+            }
+
         private:
 
             /**
@@ -96,14 +108,24 @@ namespace ldmx {
             SimParticleBuilder* simParticleBuilder_;
 
             /**
-             * Hex cell readout.
+             * Shared hex cell readout.
+             */
+            const EcalHexReadout* hexReadout_{&EcalHexReadout::getInstance()};
+
+            /**
+             * Output hit of each channel in the collection being written, or 
+             * nullptr, indexed by layer*(channels per layer) + hex readout 
+             * channel index.  It grows to the deepest layer seen and is kept 
+             * between collections so that merging hits is a direct lookup 
+             * with no allocation.
              */
-            EcalHexReadout hexReadout_;
+            std::vector<SimCalorimeterHit*> channelHits_;
 
             /**
-             * ECal detector ID.
+             * Slots of channelHits_ filled by the last collection, used to 
+             * clear only those slots.
              */
-            EcalDetectorID detID_;
+            std::vector<unsigned> usedSlots_;
 
             /**
              * Enable hit contribution output.
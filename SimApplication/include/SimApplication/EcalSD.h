@@ -34,9 +34,11 @@ namespace ldmx {
              * @param name The name of the sensitive detector.
              * @param theCollectionName The name of the hits collection.
              * @param subdet The subdetector ID.
-             * @param detID The detector ID (defaults to ECal ID).
+             * @param idCodec The codec of the detector ID (defaults to ECal ID).
+             * @param hexReadout The hex readout of the detector's ECal geometry.
              */
-            EcalSD(G4String name, G4String theCollectionName, int subdet, DetectorID* detID = new EcalDetectorID);
+            EcalSD(G4String name, G4String theCollectionName, int subdet, const IDCodec& idCodec = EcalDetectorID().getCodec(),
+                    const EcalHexReadout& hexReadout = EcalHexReadout::getInstance());
 
             /**
              * Class destructor.
@@ -65,9 +67,9 @@ namespace ldmx {
         private:
 
             /**
-             * The hex readout defining the cell grid.
+             * The shared hex readout defining the cell grid.
              */
-            EcalHexReadout* hitMap_;
+            const EcalHexReadout* hitMap_;
 
             /**
              * Map of polygonal layers for getting Z positions.
@@ -26,7 +26,7 @@ namespace ldmx {
 
         public:
 
-            HcalSD(G4String name, G4String theCollectionName, int subdet, DetectorID* detID = new HcalID);
+            HcalSD(G4String name, G4String theCollectionName, int subdet, const IDCodec& idCodec = HcalID().getCodec());
 
             virtual ~HcalSD();
 
@@ -26,6 +26,7 @@
 //   LDMX   //
 //----------//
 #include "DetDescr/DetectorID.h"
+#include "DetDescr/IDCodec.h"
 #include "DetDescr/IDField.h"
 #include "Event/Event.h"
 #include "SimApplication/G4TrackerHit.h"
@@ -42,9 +43,9 @@ namespace ldmx {
              * @param name The name of the sensitive detector.
              * @param collectionID The name of the hits collection.
              * @param subDetID The subdetector ID.
-             * @param detID The detector ID.
+             * @param idCodec The codec of the detector ID, which is copied.
              */
-            ScoringPlaneSD(G4String name, G4String colName, int subDetID, DetectorID* detID);
+            ScoringPlaneSD(G4String name, G4String colName, int subDetID, const IDCodec& idCodec);
 
             /** Destructor */
             ~ScoringPlaneSD(); 
@@ -76,12 +77,15 @@ namespace ldmx {
             /** Output hits collection */
             G4TrackerHitsCollection* hitsCollection_{nullptr};
             
-            /** The detector ID. */
-            DetectorID* detID_{nullptr};
+            /** The codec of the detector ID. */
+            IDCodec idCodec_;
             
             /** The subdetector ID. */
             int subDetID_{0};
 
+            /** The ID with only the subdetector field set. */
+            IDCodec::RawValue subDetRawID_{0};
+
     }; // ScoringPlaneSD
 } // ldmx
 
@@ -33,9 +33,9 @@ namespace ldmx {
              * @param name The name of the sensitive detector.
              * @param theCollectionName The name of the hits collection.
              * @param subdetID The subdetector ID.
-             * @param detID The detector ID.
+             * @param idCodec The codec of the detector ID, which is copied.
              */
-            TrackerSD(G4String name, G4String theCollectionName, int subdetID, DetectorID* detID);
+            TrackerSD(G4String name, G4String theCollectionName, int subdetID, const IDCodec& idCodec);
 
             /**
              * Class destructor.
@@ -43,12 +43,10 @@ namespace ldmx {
             virtual ~TrackerSD();
 
             /**
-             * Set the detector ID.
-             * @param detID The detector ID.
+             * Set the codec of the detector ID.
+             * @param idCodec The codec of the detector ID, which is copied.
              */
-            void setDetectorID(DetectorID* detID) {
-                this->detID_ = detID;
-            }
+            void setIDCodec(const IDCodec& idCodec);
 
             /**
              * Process a step by creating a hit.
@@ -82,9 +80,25 @@ namespace ldmx {
             int subdetID_;
 
             /**
-             * The detector ID.
+             * The codec of the detector ID.  Hit IDs are packed into local
+             * values, so processing hits writes no shared state.
              */
-            DetectorID* detID_{new TrackerID};
+            IDCodec idCodec_;
+
+            /**
+             * The ID with only the subdetector field set.
+             */
+            IDCodec::RawValue subdetRawID_{0};
+
+            /**
+             * The index of the layer field in the detector ID.
+             */
+            int layerIndex_{-1};
+
+            /**
+             * The index of the module field in the detector ID.
+             */
+            int moduleIndex_{-1};
     };
 
 }
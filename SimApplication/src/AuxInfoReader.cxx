@@ -13,6 +13,8 @@
 #include "DetDescr/DetectorIDStore.h"
 #include "DetDescr/DefaultDetectorID.h"
 #include "DetDescr/EcalDetectorID.h"
+#include "DetDescr/EcalHexReadout.h"
+#include "DetDescr/TrackerID.h"
 
 // Geant4
 #include "G4LogicalVolumeStore.hh"
@@ -116,31 +118,31 @@ namespace ldmx {
         /*
          * Use the default detector ID or create one from information supplied in the userinfo block, if present.
          */
-        DetectorID* detID = new DefaultDetectorID();
+        IDCodec idCodec = DefaultDetectorID().getCodec();
         if (idName != "") {
-            detID = DetectorIDStore::getInstance()->getID(idName);
-            if (!detID) {
+            const IDCodec* storedCodec = DetectorIDStore::getInstance()->getCodec(idName);
+            if (!storedCodec) {
                 std::cerr << "The Detector ID" << idName << " does not exist.  Is it defined before the SensDet in userinfo?" << std::endl;
                 G4Exception("", "", FatalException, "The referenced Detector ID was not found.");
             }
+            idCodec = *storedCodec;
         }
         /*
-         * Build the Sensitive Detector, and re-assign the detID if applicable
+         * Build the Sensitive Detector, and re-assign the ID codec if applicable
          */
         G4VSensitiveDetector* sd = 0;
 
         if (sdType == "TrackerSD") {
-            sd = new TrackerSD(theSensDetName, hcName, subdetID, detID);
+            // tracker hit IDs need a module field, which the default ID lacks
+            sd = new TrackerSD(theSensDetName, hcName, subdetID, idName != "" ? idCodec : TrackerID().getCodec());
         } else if (sdType == "EcalSD") {
-            detID = new EcalDetectorID();
-            sd = new EcalSD(theSensDetName, hcName, subdetID, detID);
+            sd = new EcalSD(theSensDetName, hcName, subdetID, EcalDetectorID().getCodec(), EcalHexReadout::getInstance(getEcalGeometry()));
         } else if (sdType == "HcalSD") {
-            detID = new HcalID();
-            sd = new HcalSD(theSensDetName, hcName, subdetID, detID);
+            sd = new HcalSD(theSensDetName, hcName, subdetID, HcalID().getCodec());
         } else if (sdType == "CalorimeterSD") {
-            sd = new CalorimeterSD(theSensDetName, hcName, subdetID, detID);
+            sd = new CalorimeterSD(theSensDetName, hcName, subdetID, idCodec);
         } else if (sdType == "ScoringPlaneSD") { 
-            sd = new ScoringPlaneSD(theSensDetName, hcName, subdetID, detID); 
+            sd = new ScoringPlaneSD(theSensDetName, hcName, subdetID, idCodec); 
         } else {
             std::cerr << "Unknown SensitiveDetector type: " << sdType << std::endl;
             G4Exception("", "", FatalException, "Unknown SensitiveDetector type in aux info.");
@@ -273,7 +275,12 @@ namespace ldmx {
         }
 
         DetectorID* id = new DetectorID(fieldList);
-        DetectorIDStore::getInstance()->addID(idName, id);
+        try {
+            DetectorIDStore::getInstance()->addID(idName, id);
+        } catch (const std::invalid_argument& e) {
+            std::cerr << e.what() << std::endl;
+            G4Exception("", "", FatalException, "The DetectorID is defined more than once.");
+        }
         std::cout << "Created detector ID " << idName << std::endl << std::endl;
     }
 
@@ -464,6 +471,31 @@ namespace ldmx {
         std::cout << "Created VisAttributes " << name << std::endl << (*visAttributes) << std::endl << std::endl;
     }
 
+    const EcalHexReadout::Geometry& AuxInfoReader::getEcalGeometry() {
+        if (hasEcalGeometry_) {
+            return ecalGeometry_;
+        }
+        if (parser_->IsValid("Hex_radius") && parser_->IsValid("hexagon_gap")) {
+            ecalGeometry_ = EcalHexReadout::Geometry{parser_->GetVariable("Hex_radius"), parser_->GetVariable("hexagon_gap"),
+                                                     EcalHexReadout::defaultNCellsWide};
+        } else {
+            /*
+             * Older GDML is looked up by the detector name, so the DetectorVersion should come before the SensDet in userinfo.
+             */
+            if (!detectorHeader_) {
+                G4Exception("", "", FatalException, "The ECal geometry needs the DetectorVersion.  Is it defined before the SensDet in userinfo?");
+            }
+            try {
+                ecalGeometry_ = EcalHexReadout::getDetectorGeometry(detectorHeader_->getName());
+            } catch (const std::invalid_argument& e) {
+                std::cerr << e.what() << std::endl;
+                G4Exception("", "", FatalException, "The GDML is missing the Hex_radius and hexagon_gap of the ECal.");
+            }
+        }
+        hasEcalGeometry_ = true;
+        return ecalGeometry_;
+    }
+
     void AuxInfoReader::createDetectorHeader(G4String auxValue, const G4GDMLAuxListType* auxInfoList) {
 
         int detectorVersion = atoi(auxValue.c_str());
@@ -12,8 +12,8 @@
 
 namespace ldmx {
 
-    CalorimeterSD::CalorimeterSD(G4String name, G4String theCollectionName, int subdetID, DetectorID* detID) :
-            G4VSensitiveDetector(name), hitsCollection_(0), subdet_(subdetID), detID_(detID) {
+    CalorimeterSD::CalorimeterSD(G4String name, G4String theCollectionName, int subdetID, const IDCodec& idCodec) :
+            G4VSensitiveDetector(name), hitsCollection_(0), subdet_(subdetID), idCodec_(idCodec) {
 
         // Add the collection name to vector of names.
         this->collectionName.push_back(theCollectionName);
@@ -22,11 +22,14 @@ namespace ldmx {
         G4SDManager::GetSDMpointer()->AddNewDetector(this);
 
         // Set the subdet ID as it will always be the same for every hit.
-        detID_->setFieldValue("subdet", subdet_);
+        int subdetIndex = idCodec_.getFieldIndex("subdet");
+        if (subdetIndex < 0) {
+            G4Exception("", "", FatalException, "The detector ID has no subdet field.");
+        }
+        subdetRawID_ = idCodec_.encode(0, subdetIndex, subdet_);
     }
 
     CalorimeterSD::~CalorimeterSD() {
-        delete detID_;
     }
 
     void CalorimeterSD::Initialize(G4HCofThisEvent* hce) {
@@ -77,8 +80,7 @@ namespace ldmx {
 
         // Set the ID on the hit.
         int layerNumber = prePoint->GetTouchableHandle()->GetHistory()->GetVolume(layerDepth_)->GetCopyNo();
-        detID_->setFieldValue(1, layerNumber);
-        hit->setID(detID_->pack());
+        hit->setID(idCodec_.encode(subdetRawID_, 1, layerNumber));
 
         // Set the track ID on the hit.
         hit->setTrackID(aStep->GetTrack()->GetTrackID());
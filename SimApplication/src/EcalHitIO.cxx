@@ -1,7 +1,8 @@
 #include "SimApplication/EcalHitIO.h"
 
 // STL
-#include <map>
+#include <stdexcept>
+#include <string>
 
 // LDMX
 #include "Event/SimCalorimeterHit.h"
@@ -16,7 +17,14 @@ namespace ldmx {
     void EcalHitIO::writeHitsCollection(G4CalorimeterHitsCollection* hc, TClonesArray* outputColl) {
 
         int nHits = hc->GetSize();
-        std::map<int, SimCalorimeterHit*> hitMap;
+        int nChannels = hexReadout_->getNumChannels();
+
+        // Forget the hits of the previous collection, touching only the 
+        // slots that were used.
+        for (unsigned slot : usedSlots_) {
+            channelHits_[slot] = nullptr;
+        }
+        usedSlots_.clear();
 
         // Loop over input hits from Geant4.
         for (int iHit = 0; iHit < nHits; iHit++) {
@@ -25,34 +33,29 @@ namespace ldmx {
             G4CalorimeterHit* g4hit = (G4CalorimeterHit*) hc->GetHit(iHit);
             int hitID = g4hit->getID();
 
-            // See if hit exists in map already.
-            std::map<int, SimCalorimeterHit*>::iterator it = hitMap.find(hitID);
-            SimCalorimeterHit* simHit;
+            // Find the slot of the hit's channel in the merge table.
+            EcalDetectorID::Fields fields = EcalDetectorID::decode(hitID);
+            int channel = hexReadout_->getChannelIndex(hexReadout_->combineID(fields.cell, fields.module));
+            if (channel < 0) {
+                throw std::out_of_range("Error: hit ID " + std::to_string(hitID) + " is not a valid ECal channel");
+            }
+            unsigned slot = fields.layer*nChannels + channel;
+            if (slot >= channelHits_.size()) channelHits_.resize((fields.layer + 1)*nChannels, nullptr);
+            SimCalorimeterHit*& simHit = channelHits_[slot];
 
             // Is it a new hit?
-            if (it == hitMap.end()) {
+            if (!simHit) {
 
                 // Create sim hit and assign the ID.
                 simHit = (SimCalorimeterHit*) outputColl->ConstructedAt(outputColl->GetEntries());
                 simHit->setID(hitID);
+                usedSlots_.push_back(slot);
 
                 /**
-                 * Assign XY position to the hit using the ECal hex readout.
+                 * Assign XY position to the hit from the channel position table of the ECal hex readout.
                  * Z position is set from the original hit, which should be the middle of the sensor.
                  */
-                detID_.setRawValue(hitID);
-                detID_.unpack();
-                int cellID = detID_.getFieldValue("cell");
-                int moduleID = detID_.getFieldValue("module_position");
-                int cellModuleID = hexReadout_.combineID(cellID,moduleID);
-                std::pair<double,double> XYPair = hexReadout_.getCellCenterAbsolute(cellModuleID);
-                simHit->setPosition(XYPair.first, XYPair.second, g4hit->getPosition().z());
-
-                hitMap[hitID] = simHit;
-
-            } else {
-                // Get existing hit from map.
-                simHit = hitMap[hitID];
+                simHit->setPosition(hexReadout_->getChannelX(channel), hexReadout_->getChannelY(channel), g4hit->getPosition().z());
             }
 
             // Get info from the G4 hit.
@@ -81,7 +84,8 @@ namespace ldmx {
                 } else {
 
                     // Add a hit contrib because all steps are being saved or there is not an existing record.
-                    simHit->addContrib(simParticle, pdgCode, edep, time);
+                    simHit->addContrib(simParticle, pdgCode, edep, time, 
+                            simParticle != nullptr ? simParticle->getTrackID() : -1);
 
                     //std::cout << "added new contrib for hit with ID " << hitID << " with PDGID = "
                     //        << pdgCode << ", edep = " << edep << ", time = " << time << std::endl;
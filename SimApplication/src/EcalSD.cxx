@@ -13,8 +13,8 @@
 
 namespace ldmx {
 
-    EcalSD::EcalSD(G4String name, G4String theCollectionName, int subdetID, DetectorID* detID) :
-            CalorimeterSD(name, theCollectionName, subdetID, detID), hitMap_(new EcalHexReadout) {
+    EcalSD::EcalSD(G4String name, G4String theCollectionName, int subdetID, const IDCodec& idCodec, const EcalHexReadout& hexReadout) :
+            CalorimeterSD(name, theCollectionName, subdetID, idCodec), hitMap_(&hexReadout) {
     }
 
     EcalSD::~EcalSD() {
@@ -61,10 +61,10 @@ namespace ldmx {
 
         int cellModuleID = hitMap_->getCellModuleID(hitPosition[0], hitPosition[1]);
 	int cellID = (hitMap_->separateID(cellModuleID)).first;
-        detID_->setFieldValue(1, layerNumber);
-        detID_->setFieldValue(2, module_position);
-	detID_->setFieldValue(3, cellID);
-        hit->setID(detID_->pack());
+        IDCodec::RawValue id = idCodec_.encode(subdetRawID_, 1, layerNumber);
+        id = idCodec_.encode(id, 2, module_position);
+        id = idCodec_.encode(id, 3, cellID);
+        hit->setID(id);
 
 	// Set the track ID on the hit.
         hit->setTrackID(aStep->GetTrack()->GetTrackID());
@@ -13,8 +13,8 @@
 
 namespace ldmx {
 
-    HcalSD::HcalSD(G4String name, G4String theCollectionName, int subdetID, DetectorID* detID) :
-            CalorimeterSD(name, theCollectionName, subdetID, detID) {
+    HcalSD::HcalSD(G4String name, G4String theCollectionName, int subdetID, const IDCodec& idCodec) :
+            CalorimeterSD(name, theCollectionName, subdetID, idCodec) {
     }
 
     HcalSD::~HcalSD() {}
@@ -72,10 +72,10 @@ namespace ldmx {
         else if (section==HcalSection::LEFT || section==HcalSection::RIGHT) stripID = int( (localPosition.y()+scint->GetYHalfLength())/100.0);
 
 
-        detID_->setFieldValue(1, layer);
-        detID_->setFieldValue(2, section);
-        detID_->setFieldValue(3, stripID);
-        hit->setID(detID_->pack());
+        IDCodec::RawValue id = idCodec_.encode(subdetRawID_, 1, layer);
+        id = idCodec_.encode(id, 2, section);
+        id = idCodec_.encode(id, 3, stripID);
+        hit->setID(id);
 
         // Set the track ID on the hit.
         hit->setTrackID(aStep->GetTrack()->GetTrackID());
@@ -83,6 +83,10 @@ namespace ldmx {
 
         // Create map with output hits collections.
         setupHitsCollectionMap();
+
+        // Assign ECal hits to the cells of the detector's hex readout.
+        DetectorConstruction* detector = ((RunManager*) RunManager::GetRunManager())->getDetectorConstruction();
+        ecalHitIO_->setHexReadout(EcalHexReadout::getInstance(detector->getEcalGeometry()));
     }
 
     void RootPersistencyManager::buildEvent(const G4Event* anEvent, Event* outputEvent) {
@@ -253,7 +257,8 @@ namespace ldmx {
             const G4ThreeVector& pos = g4hit->getPosition();
             simHit->setPosition(pos.x(), pos.y(), pos.z());
             SimParticle* particle = simParticleBuilder_.findSimParticle(g4hit->getTrackID());
-            simHit->addContrib(particle, g4hit->getPdgCode(), g4hit->getEdep(), g4hit->getTime());
+            simHit->addContrib(particle, g4hit->getPdgCode(), g4hit->getEdep(), g4hit->getTime(), 
+                    particle != nullptr ? particle->getTrackID() : -1);
         }
     }
 
@@ -269,6 +274,11 @@ namespace ldmx {
         // Set parameter value with number of events processed.
         runHeader->setIntParameter("EVENT_COUNT", aRun->GetNumberOfEvent());
 
+        // Store the ECal geometry so the reconstruction can rebuild its hex readout.
+        const EcalHexReadout::Geometry& ecalGeometry = detector->getEcalGeometry();
+        runHeader->setFloatParameter(EventConstants::ECAL_HEX_RADIUS, ecalGeometry.moduleMinR);
+        runHeader->setFloatParameter(EventConstants::ECAL_HEX_GAP, ecalGeometry.gap);
+
         // Print information about run header.
         if (m_verbose > 1) {
             std::cout << std::endl;
@@ -8,9 +8,9 @@
 
 namespace ldmx {
 
-    ScoringPlaneSD::ScoringPlaneSD(G4String name, G4String colName, int subDetID, DetectorID* detID) :
+    ScoringPlaneSD::ScoringPlaneSD(G4String name, G4String colName, int subDetID, const IDCodec& idCodec) :
             G4VSensitiveDetector(name),
-            detID_(detID),
+            idCodec_(idCodec),
             subDetID_(subDetID) { 
 
         // Add the collection name to vector of names.
@@ -20,11 +20,14 @@ namespace ldmx {
         G4SDManager::GetSDMpointer()->AddNewDetector(this);
 
         // Set the subdet ID as it will always be the same for every hit.
-        detID_->setFieldValue("subdet", subDetID_);
+        int subdetIndex = idCodec_.getFieldIndex("subdet");
+        if (subdetIndex < 0) {
+            G4Exception("", "", FatalException, "The detector ID has no subdet field.");
+        }
+        subDetRawID_ = idCodec_.encode(0, subdetIndex, subDetID_);
     }
 
     ScoringPlaneSD::~ScoringPlaneSD() {
-        delete detID_;
     }
 
     G4bool ScoringPlaneSD::ProcessHits(G4Step* step, G4TouchableHistory* history) {
@@ -72,8 +75,7 @@ namespace ldmx {
          * Set the 32-bit ID on the hit.
          */
         int cpNumber = prePoint->GetTouchableHandle()->GetCopyNumber();
-        detID_->setFieldValue(1, cpNumber);
-        hit->setID(detID_->pack());
+        hit->setID(idCodec_.encode(subDetRawID_, 1, cpNumber));
         hit->setLayerID(cpNumber);
 
         /*
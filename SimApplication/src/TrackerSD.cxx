@@ -15,8 +15,8 @@
 
 namespace ldmx {
 
-    TrackerSD::TrackerSD(G4String name, G4String theCollectionName, int subdetID, DetectorID* detID) :
-            G4VSensitiveDetector(name), hitsCollection_(0), subdetID_(subdetID), detID_(detID) {
+    TrackerSD::TrackerSD(G4String name, G4String theCollectionName, int subdetID, const IDCodec& idCodec) :
+            G4VSensitiveDetector(name), hitsCollection_(0), subdetID_(subdetID), idCodec_(idCodec) {
 
         // Add the collection name to vector of names.
         this->collectionName.push_back(theCollectionName);
@@ -25,11 +25,26 @@ namespace ldmx {
         G4SDManager::GetSDMpointer()->AddNewDetector(this);
 
         // Set the subdet ID as it will always be the same for every hit.
-        detID_->setFieldValue("subdet", subdetID_);
+        setIDCodec(idCodec);
     }
 
     TrackerSD::~TrackerSD() {
-        delete detID_;
+    }
+
+    void TrackerSD::setIDCodec(const IDCodec& idCodec) {
+        idCodec_ = idCodec;
+        int subdetIndex = idCodec_.getFieldIndex("subdet");
+        if (subdetIndex < 0) {
+            G4Exception("", "", FatalException, "The detector ID has no subdet field.");
+        }
+        subdetRawID_ = idCodec_.encode(0, subdetIndex, subdetID_);
+
+        // find the fields once, so an ID without them fails here rather than for every hit
+        layerIndex_ = idCodec_.getFieldIndex("layer");
+        moduleIndex_ = idCodec_.getFieldIndex("module");
+        if (layerIndex_ < 0 || moduleIndex_ < 0) {
+            G4Exception("", "", FatalException, "The tracker detector ID needs layer and module fields.");
+        }
     }
 
     G4bool TrackerSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
@@ -102,9 +117,8 @@ namespace ldmx {
         int copyNum = prePoint->GetTouchableHandle()->GetHistory()->GetVolume(2)->GetCopyNo();
         int layer = copyNum / 10;
         int module = copyNum % 10;
-        detID_->setFieldValue(1, layer);
-        detID_->setFieldValue(2, module);
-        hit->setID(detID_->pack());
+        IDCodec::RawValue id = idCodec_.encode(subdetRawID_, layerIndex_, layer);
+        hit->setID(idCodec_.encode(id, moduleIndex_, module));
         hit->setLayerID(layer);
         hit->setModuleID(module); 
 
@@ -41,6 +41,23 @@ namespace ldmx {
              */
             std::vector<double> generateNoiseHits(int emptyChannels); 
 
+            /**
+             * Generate Gaussian noise (mean pedestal, width noise) for a 
+             * block of channels at once.  The uniform deviates are drawn in
+             * a single call and converted with the Box-Muller transform in 
+             * a branch-free loop that the compiler can vectorize.
+             *
+             * @param nChannels The number of channels to generate noise for.
+             * @param noise Output buffer, resized to nChannels.
+             */
+            void generateGaussianNoise(int nChannels, std::vector<double>& noise); 
+
+            /** 
+             * Reseed the random number generator e.g. at the start of each
+             * event so that the generated noise is reproducible.
+             */
+            void setSeed(unsigned int seed) { random_->SetSeed(seed); }
+
             /** Set the noise threshold. */
             void setNoiseThreshold(double noiseThreshold) { noiseThreshold_ = noiseThreshold; }
 
@@ -64,6 +81,9 @@ namespace ldmx {
             /** Pedestal or baseline. */
             double pedestal_{0};  
 
+            /** Buffer of uniform deviates used by generateGaussianNoise. */
+            std::vector<double> uniforms_;
+
     }; // NoiseGenerator
 
 } // ldmx
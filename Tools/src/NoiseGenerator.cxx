@@ -6,6 +6,11 @@
 
 #include "Tools/NoiseGenerator.h"
 
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <cmath>
+
 namespace ldmx { 
 
     NoiseGenerator::NoiseGenerator() {
@@ -54,4 +59,31 @@ namespace ldmx {
        return noiseHits;  
     }
 
+    void NoiseGenerator::generateGaussianNoise(int nChannels, std::vector<double>& noise) { 
+
+        // Box-Muller produces values in pairs: the first half of the output
+        // is filled with the cosine branch and the second with the sine one.
+        int nPairs = (nChannels + 1)/2; 
+        uniforms_.resize(2*nPairs); 
+        noise.resize(2*nPairs); 
+        if (nPairs == 0) return; 
+
+        // TRandom3 returns values in (0, 1] so the log is always defined.
+        random_->RndmArray(2*nPairs, uniforms_.data());
+
+        const double twoPi = 2*M_PI; 
+        const double* u1 = uniforms_.data(); 
+        const double* u2 = uniforms_.data() + nPairs; 
+        double* cosBranch = noise.data(); 
+        double* sinBranch = noise.data() + nPairs; 
+        for (int iPair = 0; iPair < nPairs; ++iPair) { 
+            double r = noise_*std::sqrt(-2.0*std::log(u1[iPair])); 
+            double phi = twoPi*u2[iPair]; 
+            cosBranch[iPair] = pedestal_ + r*std::cos(phi); 
+            sinBranch[iPair] = pedestal_ + r*std::sin(phi); 
+        }
+
+        noise.resize(nChannels); 
+    }
+
 } // ldmx